@@ -97,6 +97,16 @@ module PileUpMerger PileUpMerger {
   # pre-generated minbias input file
   set PileUpFile MinBias.pileup
 
+  # memory in MB used to keep decoded pile-up events for reuse
+  set CacheSize 0
+
+  # number of pile-up events read ahead in a background thread
+  set PrefetchSize 0
+
+  # bins in z and t of the table used to sample the vertex distribution
+  # (0 = sample the formula with TF2::GetRandom2)
+  set VertexTableBins 200
+
   # Get rid of beam spot from http://red-gridftp11.unl.edu/Snowmass/MinBias100K_14TeV.pileup ...
   set InputBSX 2.44
   set InputBSY 3.39
@@ -67,6 +67,16 @@ module PileUpMerger PileUpMerger {
   # pre-generated minbias input file
   set PileUpFile MinBias.pileup
 
+  # memory in MB used to keep decoded pile-up events for reuse
+  set CacheSize 0
+
+  # number of pile-up events read ahead in a background thread
+  set PrefetchSize 0
+
+  # bins in z and t of the table used to sample the vertex distribution
+  # (0 = sample the formula with TF2::GetRandom2)
+  set VertexTableBins 200
+
   # average expected pile up
   set MeanPileUp 50
 
@@ -55,6 +55,11 @@ module PhotonConversions PhotonConversions {
   # unit: m-1
   
   set Step 0.05
+
+  # the map is integrated once along EtaBins x PhiBins rays from the origin
+
+  set EtaBins 100
+  set PhiBins 36
   
   set ConversionMap {          (abs(z) > 0.0 && abs(z) < 12.0 ) * (0.07) +
                                (abs(z) > 0.0) * (0.00) +
@@ -4,11 +4,29 @@
 
 set MaxEvents 10
 # set SkipEvents
+# events decoded ahead by a reader thread (0 = read in the event loop)
+set PrefetchEvents 0
+# Pythia8 instances generating events on worker threads in DelphesPythia8,
+# each one PrefetchEvents (or 2) events ahead (0 = generate in the event loop)
+set PythiaThreads 0
+# jump over skipped events with input_file.idx, written on the first complete read
+# and rebuilt when the input file changes (off by default)
+set EventIndex false
+# only stable particles and partons in Delphes/allParticles, other generator
+# particles are created when modules follow M1, M2, D1, D2 (and are not written)
+set LazyParticles false
 
 # scaling for vertexing and tracking smearing / covariance
 set TrackSmear 1.0
 set CovScale 1.0
 
+# parameter scan: the listed modules and everything downstream of them
+# are run once per value, with "_scan<index>" appended to the module
+# names, output branches and HDF5 file names
+# add ScanParameters {module} {parameter} {values}
+# add ScanParameters TrackParSmearing SmearingMultiple {0.5 1.0 1.5 2.0}
+# set ScanSuffix _scan
+
 set ExecutionPath {
   ParticlePropagator
 
@@ -632,4 +650,9 @@ module HDF5Writer HDF5Writer {
   set TextFileExtension .ntuple.txt
   set PTMin 20
   set AbsEtaMax 2.5
+  # write tracks to flat tables instead of variable-length jet members
+  set FlatTracks false
+  # also write zero-padded (jets x tracks) arrays with this many tracks
+  # per jet, largest signed d0 first, 0 to disable
+  set MaxPaddedTracks 0
 }
@@ -0,0 +1,81 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesArrayView_h
+#define DelphesArrayView_h
+
+/** \class DelphesArrayView
+ *
+ *  Typed view of the objects stored in a TObjArray. It walks the
+ *  array storage directly, so it can be used in a range-based for loop
+ *  instead of a heap-allocated TIterator and its virtual Next calls:
+ *
+ *    for(Candidate *candidate : CandidateArrayView(fInputArray)) { ... }
+ *
+ *  The view is only valid while the array is not modified.
+ *
+ */
+
+#include "TObjArray.h"
+
+class Candidate;
+
+template< typename T >
+class DelphesArrayView
+{
+public:
+
+  class Iterator
+  {
+  public:
+
+    Iterator(TObject *const *pointer) : fPointer(pointer) {}
+
+    T *operator*() const { return static_cast< T * >(*fPointer); }
+
+    Iterator &operator++() { ++fPointer; return *this; }
+
+    bool operator==(const Iterator &other) const { return fPointer == other.fPointer; }
+    bool operator!=(const Iterator &other) const { return fPointer != other.fPointer; }
+
+  private:
+
+    TObject *const *fPointer;
+  };
+
+  DelphesArrayView(const TObjArray *array) :
+    fBegin(array->GetObjectRef()), fSize(array->GetEntriesFast())
+  {
+  }
+
+  Int_t GetEntries() const { return fSize; }
+
+  T *operator[](Int_t index) const { return static_cast< T * >(fBegin[index]); }
+
+  Iterator begin() const { return Iterator(fBegin); }
+  Iterator end() const { return Iterator(fBegin + fSize); }
+
+private:
+
+  TObject *const *fBegin;
+  Int_t fSize;
+};
+
+typedef DelphesArrayView< Candidate > CandidateArrayView;
+
+#endif /* DelphesArrayView_h */
@@ -143,15 +143,19 @@ Candidate::Candidate() :
   SumPtNeutral(-999),
   SumPtChargedPU(-999),
   SumPt(-999),
-  NSubJetsTrimmed(0),
-  NSubJetsPruned(0),
-  NSubJetsSoftDropped(0),
   fFactory(0),
   fArray(0),
   fSubjetArray(0),
-  fTrackArray(0)
+  fTrackArray(0),
+  fTrackParameters(0),
+  fVertexing(0),
+  fSubstructure(0),
+  fCalorimeter(0),
+  fUseTrackParameters(kFALSE),
+  fUseVertexing(kFALSE),
+  fUseSubstructure(kFALSE),
+  fUseCalorimeter(kFALSE)
 {
-  int i;
   Edges[0] = 0.0;
   Edges[1] = 0.0;
   Edges[2] = 0.0;
@@ -161,24 +165,147 @@ Candidate::Candidate() :
   FracPt[2] = 0.0;
   FracPt[3] = 0.0;
   FracPt[4] = 0.0;
-  Tau[0] = 0.0;
-  Tau[1] = 0.0;
-  Tau[2] = 0.0;
-  Tau[3] = 0.0;
-  Tau[4] = 0.0;
+}
+
+//------------------------------------------------------------------------------
+
+Candidate::~Candidate()
+{
+  DeleteBlocks();
+}
+
+//------------------------------------------------------------------------------
 
+CandidateTrackParameters::CandidateTrackParameters()
+{
+  Clear();
+}
+
+void CandidateTrackParameters::Clear()
+{
   for(int i=0;i<5;i++)
    trkPar[i]=0;
   for(int i=0;i<15;i++)
    trkCov[i]=0;
+}
+
+void CandidateVertexing::Clear()
+{
+  // clear the vectors to keep their capacity
+  primaryVertexTracks.clear();
+  secondaryVertices.clear();
+  hlSecVxTracks.clear();
+  primaryVertex = SecondaryVertex();
+  hlSvx = HighLevelSvx();
+  mlSvx = HighLevelSvx();
+  hlTrk = HighLevelTracking();
+  truthVertices.clear();
+}
 
+CandidateSubstructure::CandidateSubstructure() :
+  NSubJetsTrimmed(0),
+  NSubJetsPruned(0),
+  NSubJetsSoftDropped(0)
+{
+  int i;
   for(i = 0; i < 5; ++i)
   {
+    Tau[i] = 0.0;
     TrimmedP4[i].SetXYZT(0.0, 0.0, 0.0, 0.0);
     PrunedP4[i].SetXYZT(0.0, 0.0, 0.0, 0.0);
     SoftDroppedP4[i].SetXYZT(0.0, 0.0, 0.0, 0.0);
   }
+}
+
+void CandidateSubstructure::Clear()
+{
+  *this = CandidateSubstructure();
+}
+
+void CandidateCalorimeter::Clear()
+{
+  ECalEnergyTimePairs.clear();
+}
+
+//------------------------------------------------------------------------------
+
+CandidateTrackParameters &Candidate::TrackParameters()
+{
+  if(!fTrackParameters) fTrackParameters = new CandidateTrackParameters;
+  fUseTrackParameters = kTRUE;
+  return *fTrackParameters;
+}
+CandidateVertexing &Candidate::Vertexing()
+{
+  if(!fVertexing) fVertexing = new CandidateVertexing;
+  fUseVertexing = kTRUE;
+  return *fVertexing;
+}
+CandidateSubstructure &Candidate::Substructure()
+{
+  if(!fSubstructure) fSubstructure = new CandidateSubstructure;
+  fUseSubstructure = kTRUE;
+  return *fSubstructure;
+}
+CandidateCalorimeter &Candidate::Calorimeter()
+{
+  if(!fCalorimeter) fCalorimeter = new CandidateCalorimeter;
+  fUseCalorimeter = kTRUE;
+  return *fCalorimeter;
+}
+
+//------------------------------------------------------------------------------
+
+const CandidateTrackParameters &Candidate::GetTrackParameters() const
+{
+  static const CandidateTrackParameters empty;
+  return fUseTrackParameters ? *fTrackParameters : empty;
+}
+const CandidateVertexing &Candidate::GetVertexing() const
+{
+  static const CandidateVertexing empty;
+  return fUseVertexing ? *fVertexing : empty;
+}
+const CandidateSubstructure &Candidate::GetSubstructure() const
+{
+  static const CandidateSubstructure empty;
+  return fUseSubstructure ? *fSubstructure : empty;
+}
+const CandidateCalorimeter &Candidate::GetCalorimeter() const
+{
+  static const CandidateCalorimeter empty;
+  return fUseCalorimeter ? *fCalorimeter : empty;
+}
+
+//------------------------------------------------------------------------------
+
+void Candidate::ClearBlocks()
+{
+  // the blocks in use are reset, the memory stays with the candidate
+  if(fUseTrackParameters) fTrackParameters->Clear();
+  if(fUseVertexing) fVertexing->Clear();
+  if(fUseSubstructure) fSubstructure->Clear();
+  if(fUseCalorimeter) fCalorimeter->Clear();
+  fUseTrackParameters = kFALSE;
+  fUseVertexing = kFALSE;
+  fUseSubstructure = kFALSE;
+  fUseCalorimeter = kFALSE;
+}
 
+void Candidate::DeleteBlocks()
+{
+  delete fTrackParameters;
+  delete fVertexing;
+  delete fSubstructure;
+  delete fCalorimeter;
+  fTrackParameters = 0;
+  fVertexing = 0;
+  fSubstructure = 0;
+  fCalorimeter = 0;
+  fUseTrackParameters = kFALSE;
+  fUseVertexing = kFALSE;
+  fUseSubstructure = kFALSE;
+  fUseCalorimeter = kFALSE;
 }
 
 //------------------------------------------------------------------------------
@@ -297,13 +424,6 @@ void Candidate::Copy(TObject &obj) const
   object.Xd = Xd;
   object.Yd = Yd;
   object.Zd = Zd;
-  object.primaryVertexTracks = primaryVertexTracks;
-  object.secondaryVertices = secondaryVertices;
-  object.hlSecVxTracks = hlSecVxTracks;
-  object.primaryVertex = primaryVertex;
-  object.hlSvx = hlSvx;
-  object.hlTrk = hlTrk;
-  object.truthVertices = truthVertices;
 
   object.NCharged = NCharged;
   object.NNeutrals = NNeutrals;
@@ -324,43 +444,19 @@ void Candidate::Copy(TObject &obj) const
   object.FracPt[2] = FracPt[2];
   object.FracPt[3] = FracPt[3];
   object.FracPt[4] = FracPt[4];
-  object.Tau[0] = Tau[0];
-  object.Tau[1] = Tau[1];
-  object.Tau[2] = Tau[2];
-  object.Tau[3] = Tau[3];
-  object.Tau[4] = Tau[4];
-  for(int i=0;i<5;i++)
-   object.trkPar[i] = trkPar[i];
-  for(int i=0;i<15;i++)
-   object.trkCov[i] = trkCov[i];
-
-  object.TrimmedP4[0] = TrimmedP4[0];
-  object.TrimmedP4[1] = TrimmedP4[1];
-  object.TrimmedP4[2] = TrimmedP4[2];
-  object.TrimmedP4[3] = TrimmedP4[3];
-  object.TrimmedP4[4] = TrimmedP4[4];
-  object.PrunedP4[0] = PrunedP4[0];
-  object.PrunedP4[1] = PrunedP4[1];
-  object.PrunedP4[2] = PrunedP4[2];
-  object.PrunedP4[3] = PrunedP4[3];
-  object.PrunedP4[4] = PrunedP4[4];
-  object.SoftDroppedP4[0] = SoftDroppedP4[0];
-  object.SoftDroppedP4[1] = SoftDroppedP4[1];
-  object.SoftDroppedP4[2] = SoftDroppedP4[2];
-  object.SoftDroppedP4[3] = SoftDroppedP4[3];
-  object.SoftDroppedP4[4] = SoftDroppedP4[4];
-
-  object.NSubJetsTrimmed = NSubJetsTrimmed;
-  object.NSubJetsPruned = NSubJetsPruned;
-  object.NSubJetsSoftDropped = NSubJetsSoftDropped;
 
   object.fFactory = fFactory;
   object.fArray = 0;
   object.fSubjetArray = 0;
   object.fTrackArray = 0;
 
-  // copy cluster timing info
-  copy(ECalEnergyTimePairs.begin(), ECalEnergyTimePairs.end(), back_inserter(object.ECalEnergyTimePairs));
+  // copy only the optional blocks that are in use, into the blocks
+  // that the target candidate already has when possible
+  object.ClearBlocks();
+  if(fUseTrackParameters) object.TrackParameters() = *fTrackParameters;
+  if(fUseVertexing) object.Vertexing() = *fVertexing;
+  if(fUseSubstructure) object.Substructure() = *fSubstructure;
+  if(fUseCalorimeter) object.Calorimeter() = *fCalorimeter;
 
   if(fArray && fArray->GetEntriesFast() > 0)
   {
@@ -395,7 +491,6 @@ void Candidate::Copy(TObject &obj) const
 
 void Candidate::Clear(Option_t* option)
 {
-  int i;
   SetUniqueID(0);
   ResetBit(kIsReferenced);
   PID = 0;
@@ -437,7 +532,6 @@ void Candidate::Clear(Option_t* option)
   PTD = 0.0;
 
   NTimeHits = 0;
-  ECalEnergyTimePairs.clear();
 
   IsolationVar = -999;
   IsolationVarRhoCorr = -999;
@@ -451,33 +545,8 @@ void Candidate::Clear(Option_t* option)
   FracPt[2] = 0.0;
   FracPt[3] = 0.0;
   FracPt[4] = 0.0;
-  Tau[0] = 0.0;
-  Tau[1] = 0.0;
-  Tau[2] = 0.0;
-  Tau[3] = 0.0;
-  Tau[4] = 0.0;
-  for(int i=0;i<5;i++)
-   trkPar[i] = 0;
-  for(int i=0;i<15;i++)
-   trkCov[i] = 0;
-  primaryVertexTracks.clear();
-  secondaryVertices.clear();
-  primaryVertex.clear();
-  hlSecVxTracks.clear();
-  truthVertices.clear();
-  hlSvx = HighLevelSvx();
-  hlTrk = HighLevelTracking();
-
-  for(i = 0; i < 5; ++i)
-  {
-    TrimmedP4[i].SetXYZT(0.0, 0.0, 0.0, 0.0);
-    PrunedP4[i].SetXYZT(0.0, 0.0, 0.0, 0.0);
-    SoftDroppedP4[i].SetXYZT(0.0, 0.0, 0.0, 0.0);
-  }
 
-  NSubJetsTrimmed = 0;
-  NSubJetsPruned = 0;
-  NSubJetsSoftDropped = 0;
+  ClearBlocks();
 
   fArray = 0;
   fSubjetArray = 0;
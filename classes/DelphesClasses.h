@@ -584,7 +584,65 @@ namespace TrackParam{
 
 }
 
+//---------------------------------------------------------------------------
+// Optional parts of Candidate, allocated only for the objects that use them
+
+struct CandidateTrackParameters
+{
+  CandidateTrackParameters();
+  void Clear();
+
+  float trkPar[5];
+  float trkCov[15];
+};
+
+struct CandidateVertexing
+{
+  void Clear();
+
+  // secondary vertex parameters
+  std::vector<SecondaryVertexTrack> primaryVertexTracks;
+  std::vector<SecondaryVertex> secondaryVertices;
+  std::vector<SecondaryVertexTrack> hlSecVxTracks;
+  // sloppy reuse of the secondary vertex structure for some primary
+  // vertex info
+  SecondaryVertex primaryVertex;
+  HighLevelSvx hlSvx;
+  HighLevelSvx mlSvx;
+  // track-based b-tagging
+  HighLevelTracking hlTrk;
+  // truth vertices
+  std::vector<TruthVertex> truthVertices;
+};
+
+struct CandidateSubstructure
+{
+  CandidateSubstructure();
+  void Clear();
+
+  // N-subjettiness variables
+
+  Float_t Tau[5];
+
+  // Other Substructure variables
+
+  TLorentzVector TrimmedP4[5]; // first entry (i = 0) is the total Trimmed Jet 4-momenta and from i = 1 to 4 are the trimmed subjets 4-momenta
+  TLorentzVector PrunedP4[5]; // first entry (i = 0) is the total Pruned Jet 4-momenta and from i = 1 to 4 are the pruned subjets 4-momenta
+  TLorentzVector SoftDroppedP4[5]; // first entry (i = 0) is the total SoftDropped Jet 4-momenta and from i = 1 to 4 are the pruned subjets 4-momenta
+
+  Int_t NSubJetsTrimmed; // number of subjets trimmed
+  Int_t NSubJetsPruned; // number of subjets pruned
+  Int_t NSubJetsSoftDropped; // number of subjets soft-dropped
+};
+
+struct CandidateCalorimeter
+{
+  void Clear();
+
+  std::vector< std::pair< Float_t, Float_t > > ECalEnergyTimePairs;
+};
 
+//---------------------------------------------------------------------------
 
 class Candidate: public SortableObject
 {
@@ -593,6 +651,7 @@ class Candidate: public SortableObject
 public:
 
   Candidate();
+  ~Candidate();
 
   Int_t PID;
 
@@ -635,24 +694,6 @@ public:
   Float_t Yd;
   Float_t Zd;
 
-  //track parameter variables
-  float trkPar[5];
-  float trkCov[15];
-
-  // secondary vertex parameters
-  std::vector<SecondaryVertexTrack> primaryVertexTracks;
-  std::vector<SecondaryVertex> secondaryVertices;
-  std::vector<SecondaryVertexTrack> hlSecVxTracks;
-  // sloppy reuse of the secondary vertex structure for some primary
-  // vertex info
-  SecondaryVertex primaryVertex;
-  HighLevelSvx hlSvx;
-  HighLevelSvx mlSvx;
-  // track-based b-tagging
-  HighLevelTracking hlTrk;
-  // truth vertices
-  std::vector<TruthVertex> truthVertices;
-
   // PileUpJetID variables
 
   Int_t NCharged;
@@ -666,7 +707,6 @@ public:
   // Timing information
 
   Int_t NTimeHits;
-  std::vector< std::pair< Float_t, Float_t > > ECalEnergyTimePairs;
 
   // Isolation variables
 
@@ -677,23 +717,28 @@ public:
   Float_t SumPtChargedPU;
   Float_t SumPt;
 
-  // N-subjettiness variables
+  static CompBase *fgCompare; //!
+  const CompBase *GetCompare() const { return fgCompare; }
 
-  Float_t Tau[5];
+  // Optional blocks are created on first access. Clear only resets them,
+  // so that a candidate reused by the factory keeps its allocated blocks.
+  // The Get* versions never allocate and return default values for
+  // blocks that are not in use.
 
-  // Other Substructure variables
+  CandidateTrackParameters &TrackParameters();
+  CandidateVertexing &Vertexing();
+  CandidateSubstructure &Substructure();
+  CandidateCalorimeter &Calorimeter();
 
-  TLorentzVector TrimmedP4[5]; // first entry (i = 0) is the total Trimmed Jet 4-momenta and from i = 1 to 4 are the trimmed subjets 4-momenta
-  TLorentzVector PrunedP4[5]; // first entry (i = 0) is the total Pruned Jet 4-momenta and from i = 1 to 4 are the pruned subjets 4-momenta
-  TLorentzVector SoftDroppedP4[5]; // first entry (i = 0) is the total SoftDropped Jet 4-momenta and from i = 1 to 4 are the pruned subjets 4-momenta
+  const CandidateTrackParameters &GetTrackParameters() const;
+  const CandidateVertexing &GetVertexing() const;
+  const CandidateSubstructure &GetSubstructure() const;
+  const CandidateCalorimeter &GetCalorimeter() const;
 
-  Int_t NSubJetsTrimmed; // number of subjets trimmed
-  Int_t NSubJetsPruned; // number of subjets pruned
-  Int_t NSubJetsSoftDropped; // number of subjets soft-dropped
-
-
-  static CompBase *fgCompare; //!
-  const CompBase *GetCompare() const { return fgCompare; }
+  Bool_t HasTrackParameters() const { return fUseTrackParameters; }
+  Bool_t HasVertexing() const { return fUseVertexing; }
+  Bool_t HasSubstructure() const { return fUseSubstructure; }
+  Bool_t HasCalorimeter() const { return fUseCalorimeter; }
 
   void AddCandidate(Candidate *object);
   TObjArray *GetCandidates();
@@ -716,9 +761,22 @@ private:
   TObjArray *fSubjetArray; //!
   TObjArray *fTrackArray; //!
 
+  CandidateTrackParameters *fTrackParameters; //!
+  CandidateVertexing *fVertexing; //!
+  CandidateSubstructure *fSubstructure; //!
+  CandidateCalorimeter *fCalorimeter; //!
+
+  Bool_t fUseTrackParameters; //!
+  Bool_t fUseVertexing; //!
+  Bool_t fUseSubstructure; //!
+  Bool_t fUseCalorimeter; //!
+
+  void ClearBlocks();
+  void DeleteBlocks();
+
   void SetFactory(DelphesFactory *factory) { fFactory = factory; }
 
-  ClassDef(Candidate, 3)
+  ClassDef(Candidate, 4)
 };
 
 #endif // DelphesClasses_h
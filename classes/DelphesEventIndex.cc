@@ -0,0 +1,157 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \class DelphesEventIndex
+ *
+ *  Byte offset of every event of a generator file, kept in a text file
+ *  next to it (input_file.idx). With the index, a reader can start at
+ *  any event without decoding the events before it. The size and the
+ *  modification time of the file are stored with the offsets, and an
+ *  index that doesn't match them is rebuilt.
+ *
+ */
+
+#include "classes/DelphesEventIndex.h"
+#include "classes/DelphesEventRecord.h"
+#include "classes/DelphesReader.h"
+
+#include <sys/stat.h>
+
+using namespace std;
+
+static const char *kIndexHeader = "DelphesEventIndex2";
+
+//---------------------------------------------------------------------------
+
+void DelphesEventIndex::Clear()
+{
+  fOffsets.clear();
+}
+
+//---------------------------------------------------------------------------
+
+string DelphesEventIndex::GetIndexName(const char *fileName)
+{
+  return string(fileName) + ".idx";
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesEventIndex::GetFileInfo(const char *fileName, long long &size, long long &time)
+{
+  struct stat info;
+  if(stat(fileName, &info) != 0) return false;
+  size = info.st_size;
+  time = info.st_mtime;
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesEventIndex::Load(const char *fileName)
+{
+  FILE *indexFile;
+  char header[32];
+  long long size, time, indexSize, indexTime, entries, offset, i;
+  bool rc;
+
+  Clear();
+
+  if(!GetFileInfo(fileName, size, time)) return false;
+
+  indexFile = fopen(GetIndexName(fileName).c_str(), "r");
+  if(!indexFile) return false;
+
+  rc = fscanf(indexFile, "%31s %lld %lld %lld", header, &indexSize, &indexTime, &entries) == 4
+    && string(header) == kIndexHeader && indexSize == size && indexTime == time;
+
+  for(i = 0; rc && i < entries; ++i)
+  {
+    rc = fscanf(indexFile, "%lld", &offset) == 1 && offset >= 0 && offset < size;
+    Add(offset);
+  }
+
+  fclose(indexFile);
+
+  if(!rc) Clear();
+
+  return rc;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesEventIndex::Save(const char *fileName) const
+{
+  FILE *indexFile;
+  long long size, time;
+  size_t i;
+  bool rc;
+
+  if(!GetFileInfo(fileName, size, time)) return false;
+
+  indexFile = fopen(GetIndexName(fileName).c_str(), "w");
+  if(!indexFile) return false;
+
+  rc = fprintf(indexFile, "%s %lld %lld %lld\n", kIndexHeader, size, time, GetEntries()) > 0;
+
+  for(i = 0; rc && i < fOffsets.size(); ++i)
+  {
+    rc = fprintf(indexFile, "%lld\n", fOffsets[i]) > 0;
+  }
+
+  rc = (fclose(indexFile) == 0) && rc;
+
+  if(!rc) remove(GetIndexName(fileName).c_str());
+
+  return rc;
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventIndex::Build(DelphesReader *reader, FILE *inputFile)
+{
+  DelphesEventRecord record;
+
+  Clear();
+
+  reader->SetInputFile(inputFile);
+  reader->Clear();
+
+  while(reader->ReadEvent(record))
+  {
+    Add(record.Offset);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+long long DelphesEventIndex::Seek(FILE *inputFile, long long event) const
+{
+  if(event <= 0 || fOffsets.empty()) return 0;
+
+  if(event >= GetEntries())
+  {
+    fseeko(inputFile, 0L, SEEK_END);
+    return GetEntries();
+  }
+
+  fseeko(inputFile, fOffsets[event], SEEK_SET);
+  return event;
+}
+
+//---------------------------------------------------------------------------
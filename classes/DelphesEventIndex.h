@@ -0,0 +1,71 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesEventIndex_h
+#define DelphesEventIndex_h
+
+/** \class DelphesEventIndex
+ *
+ *  Byte offset of every event of a generator file, kept in a text file
+ *  next to it (input_file.idx). With the index, a reader can start at
+ *  any event without decoding the events before it. The size and the
+ *  modification time of the file are stored with the offsets, and an
+ *  index that doesn't match them is rebuilt.
+ *
+ */
+
+#include <stdio.h>
+
+#include <vector>
+#include <string>
+
+class DelphesReader;
+
+class DelphesEventIndex
+{
+public:
+
+  void Clear();
+
+  void Add(long long offset) { fOffsets.push_back(offset); }
+
+  long long GetEntries() const { return fOffsets.size(); }
+
+  // reads the index of fileName, returns false if there is no index
+  // or if it was built for a file of different size or modification time
+  bool Load(const char *fileName);
+
+  // writes the index of fileName, returns false if it can't be written
+  bool Save(const char *fileName) const;
+
+  // reads all the events of inputFile from its current position
+  void Build(DelphesReader *reader, FILE *inputFile);
+
+  // moves inputFile to the given event, returns the number of events jumped over
+  long long Seek(FILE *inputFile, long long event) const;
+
+  static std::string GetIndexName(const char *fileName);
+
+private:
+
+  static bool GetFileInfo(const char *fileName, long long &size, long long &time);
+
+  std::vector< long long > fOffsets;
+};
+
+#endif // DelphesEventIndex_h
@@ -0,0 +1,150 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \class DelphesEventPipeline
+ *
+ *  Runs a DelphesReader on a background thread that decodes up to
+ *  a given number of events ahead into a ring of DelphesEventRecord.
+ *  The event loop takes the records with Next and creates the
+ *  candidates itself, the factory is never used by the reading thread.
+ *
+ */
+
+#include "classes/DelphesEventPipeline.h"
+#include "classes/DelphesReader.h"
+#include "classes/DelphesPDGTable.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+DelphesEventPipeline::DelphesEventPipeline(DelphesReader *reader, int depth) :
+  fReader(reader), fRecords(depth > 0 ? depth : 1), fHead(0), fCount(0),
+  fStop(false), fFinished(false)
+{
+}
+
+//---------------------------------------------------------------------------
+
+DelphesEventPipeline::~DelphesEventPipeline()
+{
+  Stop();
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventPipeline::Start()
+{
+  Stop();
+
+  // load the particle table before it is used by the thread
+  DelphesPDGTable::Instance();
+
+  fHead = 0;
+  fCount = 0;
+  fStop = false;
+  fFinished = false;
+  fError.clear();
+
+  fThread = thread(&DelphesEventPipeline::ReadLoop, this);
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventPipeline::Stop()
+{
+  if(!fThread.joinable()) return;
+  {
+    lock_guard< mutex > lock(fMutex);
+    fStop = true;
+  }
+  fNotFull.notify_all();
+  fThread.join();
+  fCount = 0;
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventPipeline::ReadLoop()
+{
+  int slot;
+  bool ready;
+
+  try
+  {
+    while(true)
+    {
+      {
+        unique_lock< mutex > lock(fMutex);
+        while(!fStop && fCount == int(fRecords.size()))
+        {
+          fNotFull.wait(lock);
+        }
+        if(fStop) return;
+        slot = (fHead + fCount) % fRecords.size();
+      }
+
+      // the slot past the last ready record is not touched by Next
+      ready = fReader->ReadEvent(fRecords[slot]);
+
+      lock_guard< mutex > lock(fMutex);
+      if(ready)
+      {
+        ++fCount;
+      }
+      else
+      {
+        fFinished = true;
+      }
+      fNotEmpty.notify_one();
+      if(!ready) return;
+    }
+  }
+  catch(exception &e)
+  {
+    lock_guard< mutex > lock(fMutex);
+    fError = e.what();
+    fFinished = true;
+    fNotEmpty.notify_one();
+  }
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesEventPipeline::Next(DelphesEventRecord &record)
+{
+  unique_lock< mutex > lock(fMutex);
+  while(fCount == 0 && !fFinished && !fStop)
+  {
+    fNotEmpty.wait(lock);
+  }
+  if(fCount == 0)
+  {
+    if(!fError.empty()) throw runtime_error(fError);
+    return false;
+  }
+  record.Swap(fRecords[fHead]);
+  fHead = (fHead + 1) % fRecords.size();
+  --fCount;
+  fNotFull.notify_one();
+  return true;
+}
+
+//---------------------------------------------------------------------------
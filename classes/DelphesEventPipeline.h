@@ -0,0 +1,74 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesEventPipeline_h
+#define DelphesEventPipeline_h
+
+/** \class DelphesEventPipeline
+ *
+ *  Runs a DelphesReader on a background thread that decodes up to
+ *  a given number of events ahead into a ring of DelphesEventRecord.
+ *  The event loop takes the records with Next and creates the
+ *  candidates itself, the factory is never used by the reading thread.
+ *
+ */
+
+#include "classes/DelphesEventRecord.h"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class DelphesReader;
+
+class DelphesEventPipeline
+{
+public:
+
+  DelphesEventPipeline(DelphesReader *reader, int depth);
+  ~DelphesEventPipeline();
+
+  // starts reading the current input file of the reader
+  void Start();
+
+  // stops the reading thread and drops the events read ahead
+  void Stop();
+
+  // swaps the next event into record, returns false at the end of the input
+  bool Next(DelphesEventRecord &record);
+
+private:
+
+  void ReadLoop();
+
+  DelphesReader *fReader;
+
+  std::vector< DelphesEventRecord > fRecords;
+  int fHead, fCount;
+
+  bool fStop, fFinished;
+  std::string fError;
+
+  std::thread fThread;
+  std::mutex fMutex;
+  std::condition_variable fNotFull, fNotEmpty;
+};
+
+#endif // DelphesEventPipeline_h
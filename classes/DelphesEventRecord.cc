@@ -0,0 +1,253 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \class DelphesEventRecord
+ *
+ *  Decoded generator event: the event header and one array per particle
+ *  property. The readers fill it without touching the candidate factory,
+ *  so that it can be filled on a different thread and turned into
+ *  candidates later by Materialize. With lazy materialisation, only the
+ *  stable particles and the partons are created up front, the other
+ *  particles are created by GetCandidate when a module asks for them.
+ *
+ */
+
+#include "classes/DelphesEventRecord.h"
+
+#include "classes/DelphesClasses.h"
+#include "classes/DelphesFactory.h"
+#include "classes/DelphesPDGTable.h"
+
+#include "TMath.h"
+#include "TObjArray.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+DelphesEventRecord::DelphesEventRecord() :
+  fPDG(0), fFactory(0)
+{
+  fPDG = &DelphesPDGTable::Instance();
+  Clear();
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventRecord::Clear()
+{
+  Offset = -1;
+  Number = 0;
+  ProcessID = 0;
+  MPI = 0;
+  Weight = 1.0;
+  Scale = 0.0;
+  ScalePDF = 0.0;
+  AlphaQED = 0.0;
+  AlphaQCD = 0.0;
+  ID1 = 0;
+  ID2 = 0;
+  X1 = 0.0;
+  X2 = 0.0;
+  PDF1 = 0.0;
+  PDF2 = 0.0;
+
+  WeightList.clear();
+
+  PID.clear();
+  Status.clear();
+  M1.clear();
+  M2.clear();
+  D1.clear();
+  D2.clear();
+  Charge.clear();
+  Px.clear();
+  Py.clear();
+  Pz.clear();
+  E.clear();
+  Mass.clear();
+  X.clear();
+  Y.clear();
+  Z.clear();
+  T.clear();
+  Output.clear();
+
+  fFactory = 0;
+  fCandidates.clear();
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventRecord::Swap(DelphesEventRecord &record)
+{
+  swap(Offset, record.Offset);
+  swap(Number, record.Number);
+  swap(ProcessID, record.ProcessID);
+  swap(MPI, record.MPI);
+  swap(Weight, record.Weight);
+  swap(Scale, record.Scale);
+  swap(ScalePDF, record.ScalePDF);
+  swap(AlphaQED, record.AlphaQED);
+  swap(AlphaQCD, record.AlphaQCD);
+  swap(ID1, record.ID1);
+  swap(ID2, record.ID2);
+  swap(X1, record.X1);
+  swap(X2, record.X2);
+  swap(PDF1, record.PDF1);
+  swap(PDF2, record.PDF2);
+
+  WeightList.swap(record.WeightList);
+
+  PID.swap(record.PID);
+  Status.swap(record.Status);
+  M1.swap(record.M1);
+  M2.swap(record.M2);
+  D1.swap(record.D1);
+  D2.swap(record.D2);
+  Charge.swap(record.Charge);
+  Px.swap(record.Px);
+  Py.swap(record.Py);
+  Pz.swap(record.Pz);
+  E.swap(record.E);
+  Mass.swap(record.Mass);
+  X.swap(record.X);
+  Y.swap(record.Y);
+  Z.swap(record.Z);
+  T.swap(record.T);
+  Output.swap(record.Output);
+
+  // the candidates belong to the event that was materialised
+  fFactory = record.fFactory = 0;
+  fCandidates.clear();
+  record.fCandidates.clear();
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventRecord::AddParticle(int pid, int status, int m1, int m2, int d1, int d2,
+  double px, double py, double pz, double e, double mass,
+  double x, double y, double z, double t)
+{
+  const DelphesPDGTable::Entry *pdgParticle;
+  int pdgCode;
+  char output;
+
+  pdgParticle = fPDG->GetEntry(pid);
+  pdgCode = TMath::Abs(pid);
+
+  output = kAll;
+  if(pdgParticle)
+  {
+    if(status == 1 && pdgParticle->Stable)
+    {
+      output = kStable;
+    }
+    else if(pdgCode <= 5 || pdgCode == 21 || pdgCode == 15)
+    {
+      output = kParton;
+    }
+  }
+
+  PID.push_back(pid);
+  Status.push_back(status);
+  M1.push_back(m1);
+  M2.push_back(m2);
+  D1.push_back(d1);
+  D2.push_back(d2);
+  Charge.push_back(pdgParticle ? pdgParticle->Charge : -999);
+  Px.push_back(px);
+  Py.push_back(py);
+  Pz.push_back(pz);
+  E.push_back(e);
+  Mass.push_back(mass);
+  X.push_back(x);
+  Y.push_back(y);
+  Z.push_back(z);
+  T.push_back(t);
+  Output.push_back(output);
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesEventRecord::Materialize(DelphesFactory *factory,
+  TObjArray *allParticleOutputArray,
+  TObjArray *stableParticleOutputArray,
+  TObjArray *partonOutputArray,
+  bool lazy)
+{
+  Candidate *candidate;
+  int i, size;
+
+  size = Size();
+
+  fFactory = factory;
+  fCandidates.assign(size, 0);
+
+  for(i = 0; i < size; ++i)
+  {
+    if(lazy && Output[i] == kAll) continue;
+
+    candidate = GetCandidate(i);
+
+    allParticleOutputArray->Add(candidate);
+
+    if(Output[i] == kStable)
+    {
+      stableParticleOutputArray->Add(candidate);
+    }
+    else if(Output[i] == kParton)
+    {
+      partonOutputArray->Add(candidate);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+
+Candidate *DelphesEventRecord::GetCandidate(int index)
+{
+  Candidate *candidate;
+
+  if(index < 0 || index >= int(fCandidates.size())) return 0;
+
+  candidate = fCandidates[index];
+  if(candidate) return candidate;
+
+  candidate = fFactory->NewCandidate();
+
+  candidate->PID = PID[index];
+  candidate->Status = Status[index];
+
+  candidate->M1 = M1[index];
+  candidate->M2 = M2[index];
+
+  candidate->D1 = D1[index];
+  candidate->D2 = D2[index];
+
+  candidate->Charge = Charge[index];
+  candidate->Mass = Mass[index];
+
+  candidate->Momentum.SetPxPyPzE(Px[index], Py[index], Pz[index], E[index]);
+  candidate->Position.SetXYZT(X[index], Y[index], Z[index], T[index]);
+
+  fCandidates[index] = candidate;
+
+  return candidate;
+}
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesEventRecord_h
+#define DelphesEventRecord_h
+
+/** \class DelphesEventRecord
+ *
+ *  Decoded generator event: the event header and one array per particle
+ *  property. The readers fill it without touching the candidate factory,
+ *  so that it can be filled on a different thread and turned into
+ *  candidates later by Materialize. With lazy materialisation, only the
+ *  stable particles and the partons are created up front, the other
+ *  particles are created by GetCandidate when a module asks for them.
+ *
+ */
+
+#include <vector>
+#include <utility>
+
+class TObjArray;
+class DelphesPDGTable;
+class Candidate;
+class DelphesFactory;
+
+class DelphesEventRecord
+{
+public:
+
+  enum ParticleOutput
+  {
+    kAll = 0,
+    kStable = 1,
+    kParton = 2
+  };
+
+  DelphesEventRecord();
+
+  void Clear();
+  void Swap(DelphesEventRecord &record);
+
+  int Size() const { return PID.size(); }
+
+  // appends one particle, the charge and the output array are taken from the PDG table
+  void AddParticle(int pid, int status, int m1, int m2, int d1, int d2,
+    double px, double py, double pz, double e, double mass,
+    double x, double y, double z, double t);
+
+  // creates the candidates and adds them to the output arrays,
+  // if lazy is set, allParticleOutputArray only gets the stable particles and partons
+  void Materialize(DelphesFactory *factory,
+    TObjArray *allParticleOutputArray,
+    TObjArray *stableParticleOutputArray,
+    TObjArray *partonOutputArray,
+    bool lazy = false);
+
+  // candidate of the particle with the given index, created if needed
+  Candidate *GetCandidate(int index);
+
+  // position in the input file where the reader started to look for this event
+  long long Offset;
+
+  // event header, union of what the readers provide
+  long long Number;
+  int ProcessID, MPI;
+  double Weight, Scale, ScalePDF, AlphaQED, AlphaQCD;
+  int ID1, ID2;
+  double X1, X2, PDF1, PDF2;
+
+  std::vector< std::pair< int, double > > WeightList;
+
+  // particles
+  std::vector< int > PID, Status, M1, M2, D1, D2, Charge;
+  std::vector< double > Px, Py, Pz, E, Mass;
+  std::vector< double > X, Y, Z, T;
+  std::vector< char > Output;
+
+private:
+
+  const DelphesPDGTable *fPDG;
+
+  DelphesFactory *fFactory;
+  std::vector< Candidate * > fCandidates;
+};
+
+#endif // DelphesEventRecord_h
@@ -28,6 +28,7 @@
 
 #include "classes/DelphesFactory.h"
 #include "classes/DelphesClasses.h"
+#include "classes/DelphesEventRecord.h"
 
 #include "ExRootAnalysis/ExRootTreeBranch.h"
 
@@ -39,7 +40,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 
 DelphesFactory::DelphesFactory(const char *name) :
-  TNamed(name, ""), fObjArrays(0)
+  TNamed(name, ""), fObjArrays(0), fEventRecord(0)
 {
   fObjArrays = new ExRootTreeBranch("PermanentObjArrays", TObjArray::Class(), 0);
 }
@@ -97,6 +98,22 @@ Candidate *DelphesFactory::NewCandidate()
 
 //------------------------------------------------------------------------------
 
+Candidate *DelphesFactory::GetGenParticle(const TObjArray *array, Int_t index)
+{
+  if(fEventRecord) return fEventRecord->GetCandidate(index);
+  return static_cast<Candidate *>(array->At(index));
+}
+
+//------------------------------------------------------------------------------
+
+Int_t DelphesFactory::GetGenParticleCount(const TObjArray *array) const
+{
+  if(fEventRecord) return fEventRecord->Size();
+  return array->GetEntriesFast();
+}
+
+//------------------------------------------------------------------------------
+
 TObject *DelphesFactory::New(TClass *cl)
 {
   TObject *object = 0;
@@ -35,6 +35,7 @@
 
 class TObjArray;
 class Candidate;
+class DelphesEventRecord;
 
 class ExRootTreeBranch;
 
@@ -58,6 +59,16 @@ public:
   template<typename T>
   T *New() { return static_cast<T *>(New(T::Class())); }
 
+  // generator record of the current event, set when the candidates
+  // of the intermediate particles are only created on demand
+  void SetEventRecord(DelphesEventRecord *record) { fEventRecord = record; }
+  DelphesEventRecord *GetEventRecord() const { return fEventRecord; }
+
+  // generator particle with the given index (M1, M2, D1, D2), taken
+  // from the event record if there is one and from array otherwise
+  Candidate *GetGenParticle(const TObjArray *array, Int_t index);
+  Int_t GetGenParticleCount(const TObjArray *array) const;
+
 private:
 
   ExRootTreeBranch *fObjArrays; //!
@@ -67,6 +78,8 @@ private:
 #endif
 
   std::set< TObject* > fPool; //!
+
+  DelphesEventRecord *fEventRecord; //!
   
   ClassDef(DelphesFactory, 1)
 };
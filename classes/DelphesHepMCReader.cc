@@ -38,8 +38,6 @@
 
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "classes/DelphesClasses.h"
@@ -55,13 +53,11 @@ static const int kBufferSize  = 1024;
 //---------------------------------------------------------------------------
 
 DelphesHepMCReader::DelphesHepMCReader() :
-  fInputFile(0), fBuffer(0), fPDG(0),
+  fInputFile(0), fBuffer(0),
   fVertexCounter(-1), fInCounter(-1), fOutCounter(-1),
   fParticleCounter(0)
 {
   fBuffer = new char[kBufferSize];
-
-  fPDG = TDatabasePDG::Instance();
 }
 
 //---------------------------------------------------------------------------
@@ -94,6 +90,7 @@ void DelphesHepMCReader::Clear()
   fMotherMap.clear();
   fDaughterMap.clear();
   fParticleCounter = 0;
+  fRecord.Clear();
 }
 
 //---------------------------------------------------------------------------
@@ -109,6 +106,45 @@ bool DelphesHepMCReader::ReadBlock(DelphesFactory *factory,
   TObjArray *allParticleOutputArray,
   TObjArray *stableParticleOutputArray,
   TObjArray *partonOutputArray)
+{
+  if(!ReadBlock()) return kFALSE;
+
+  if(EventReady())
+  {
+    fRecord.Materialize(factory, allParticleOutputArray,
+      stableParticleOutputArray, partonOutputArray);
+  }
+
+  return kTRUE;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesHepMCReader::ReadEvent(DelphesEventRecord &record)
+{
+  long long offset;
+
+  Clear();
+
+  offset = ftello(fInputFile);
+
+  while(ReadBlock())
+  {
+    if(EventReady())
+    {
+      fRecord.Offset = offset;
+      record.Swap(fRecord);
+      Clear();
+      return kTRUE;
+    }
+  }
+
+  return kFALSE;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesHepMCReader::ReadBlock()
 {
   map< int, pair< int, int > >::iterator itMotherMap;
   map< int, pair< int, int > >::iterator itDaughterMap;
@@ -278,8 +314,7 @@ bool DelphesHepMCReader::ReadBlock(DelphesFactory *factory,
       }
     }
 
-    AnalyzeParticle(factory, allParticleOutputArray,
-      stableParticleOutputArray, partonOutputArray);
+    AnalyzeParticle();
 
     if(fInCounter > 0)
     {
@@ -295,7 +330,22 @@ bool DelphesHepMCReader::ReadBlock(DelphesFactory *factory,
 
   if(EventReady())
   {
-    FinalizeParticles(allParticleOutputArray);
+    FinalizeParticles();
+
+    fRecord.Number = fEventNumber;
+    fRecord.ProcessID = fProcessID;
+    fRecord.MPI = fMPI;
+    fRecord.Weight = fWeight.size() > 0 ? fWeight[0] : 1.0;
+    fRecord.Scale = fScale;
+    fRecord.AlphaQED = fAlphaQED;
+    fRecord.AlphaQCD = fAlphaQCD;
+    fRecord.ID1 = fID1;
+    fRecord.ID2 = fID2;
+    fRecord.X1 = fX1;
+    fRecord.X2 = fX2;
+    fRecord.ScalePDF = fScalePDF;
+    fRecord.PDF1 = fPDF1;
+    fRecord.PDF2 = fPDF2;
   }
 
   return kTRUE;
@@ -305,26 +355,34 @@ bool DelphesHepMCReader::ReadBlock(DelphesFactory *factory,
 
 void DelphesHepMCReader::AnalyzeEvent(ExRootTreeBranch *branch, long long eventNumber,
   TStopwatch *readStopWatch, TStopwatch *procStopWatch)
+{
+  AnalyzeEvent(branch, fRecord, eventNumber, readStopWatch, procStopWatch);
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesHepMCReader::AnalyzeEvent(ExRootTreeBranch *branch, const DelphesEventRecord &record,
+  long long eventNumber, TStopwatch *readStopWatch, TStopwatch *procStopWatch)
 {
   HepMCEvent *element;
 
   element = static_cast<HepMCEvent *>(branch->NewEntry());
-  element->Number = fEventNumber;
-
-  element->ProcessID = fProcessID;
-  element->MPI = fMPI;
-  element->Weight = fWeight.size() > 0 ? fWeight[0] : 1.0;
-  element->Scale = fScale;
-  element->AlphaQED = fAlphaQED;
-  element->AlphaQCD = fAlphaQCD;
-
-  element->ID1 = fID1;
-  element->ID2 = fID2;
-  element->X1 = fX1;
-  element->X2 = fX2;
-  element->ScalePDF = fScalePDF;
-  element->PDF1 = fPDF1;
-  element->PDF2 = fPDF2;
+  element->Number = record.Number;
+
+  element->ProcessID = record.ProcessID;
+  element->MPI = record.MPI;
+  element->Weight = record.Weight;
+  element->Scale = record.Scale;
+  element->AlphaQED = record.AlphaQED;
+  element->AlphaQCD = record.AlphaQCD;
+
+  element->ID1 = record.ID1;
+  element->ID2 = record.ID2;
+  element->X1 = record.X1;
+  element->X2 = record.X2;
+  element->ScalePDF = record.ScalePDF;
+  element->PDF1 = record.PDF1;
+  element->PDF2 = record.PDF2;
 
   element->ReadTime = readStopWatch->RealTime();
   element->ProcTime = procStopWatch->RealTime();
@@ -332,120 +390,79 @@ void DelphesHepMCReader::AnalyzeEvent(ExRootTreeBranch *branch, long long eventN
 
 //---------------------------------------------------------------------------
 
-void DelphesHepMCReader::AnalyzeParticle(DelphesFactory *factory,
-  TObjArray *allParticleOutputArray,
-  TObjArray *stableParticleOutputArray,
-  TObjArray *partonOutputArray)
+void DelphesHepMCReader::AnalyzeParticle()
 {
-  Candidate *candidate;
-  TParticlePDG *pdgParticle;
-  int pdgCode;
-
-  candidate = factory->NewCandidate();
-
-  candidate->PID = fPID;
-  pdgCode = TMath::Abs(candidate->PID);
-
-  candidate->Status = fStatus;
-
-  pdgParticle = fPDG->GetParticle(fPID);
-  candidate->Charge = pdgParticle ? int(pdgParticle->Charge()/3.0) : -999;
-  candidate->Mass = fMass;
-
-  candidate->Momentum.SetPxPyPzE(fPx, fPy, fPz, fE);
-  if(fMomentumCoefficient != 1.0)
-  {
-    candidate->Momentum *= fMomentumCoefficient;
-  }
+  int m1, d1;
+  double x, y, z, t;
 
-  candidate->M2 = 1;
-  candidate->D2 = 1;
+  // vertex codes are replaced by particle indices in FinalizeParticles
   if(fInCounter > 0)
   {
-    candidate->M1 = 1;
-    candidate->Position.SetXYZT(0.0, 0.0, 0.0, 0.0);
+    m1 = 1;
+    x = y = z = t = 0.0;
   }
   else
   {
-    candidate->M1 = fOutVertexCode;
-    candidate->Position.SetXYZT(fX, fY, fZ, fT);
-    if(fPositionCoefficient != 1.0)
-    {
-      candidate->Position *= fPositionCoefficient;
-    }
-  }
-  if(fInVertexCode < 0)
-  {
-    candidate->D1 = fInVertexCode;
-  }
-  else
-  {
-    candidate->D1 = 1;
+    m1 = fOutVertexCode;
+    x = fX*fPositionCoefficient;
+    y = fY*fPositionCoefficient;
+    z = fZ*fPositionCoefficient;
+    t = fT*fPositionCoefficient;
   }
+  d1 = fInVertexCode < 0 ? fInVertexCode : 1;
 
-  allParticleOutputArray->Add(candidate);
-
-  if(!pdgParticle) return;
-
-  if(fStatus == 1 && pdgParticle->Stable())
-  {
-    stableParticleOutputArray->Add(candidate);
-  }
-  else if(pdgCode <= 5 || pdgCode == 21 || pdgCode == 15)
-  {
-    partonOutputArray->Add(candidate);
-  }
+  fRecord.AddParticle(fPID, fStatus, m1, 1, d1, 1,
+    fPx*fMomentumCoefficient, fPy*fMomentumCoefficient,
+    fPz*fMomentumCoefficient, fE*fMomentumCoefficient,
+    fMass, x, y, z, t);
 }
 
 //---------------------------------------------------------------------------
 
-void DelphesHepMCReader::FinalizeParticles(TObjArray *allParticleOutputArray)
+void DelphesHepMCReader::FinalizeParticles()
 {
-  Candidate *candidate;
   map< int, pair< int, int > >::iterator itMotherMap;
   map< int, pair< int, int > >::iterator itDaughterMap;
   int i;
 
-  for(i = 0; i < allParticleOutputArray->GetEntriesFast(); ++i)
+  for(i = 0; i < fRecord.Size(); ++i)
   {
-    candidate = static_cast<Candidate *>(allParticleOutputArray->At(i));
-
-    if(candidate->M1 > 0)
+    if(fRecord.M1[i] > 0)
     {
-      candidate->M1 = -1;
-      candidate->M2 = -1;
+      fRecord.M1[i] = -1;
+      fRecord.M2[i] = -1;
     }
     else
     {
-      itMotherMap = fMotherMap.find(candidate->M1);
+      itMotherMap = fMotherMap.find(fRecord.M1[i]);
       if(itMotherMap == fMotherMap.end())
       {
-        candidate->M1 = -1;
-        candidate->M2 = -1;
+        fRecord.M1[i] = -1;
+        fRecord.M2[i] = -1;
       }
       else
       {
-        candidate->M1 = itMotherMap->second.first;
-        candidate->M2 = itMotherMap->second.second;
+        fRecord.M1[i] = itMotherMap->second.first;
+        fRecord.M2[i] = itMotherMap->second.second;
       }
     }
-    if(candidate->D1 > 0)
+    if(fRecord.D1[i] > 0)
     {
-      candidate->D1 = -1;
-      candidate->D2 = -1;
+      fRecord.D1[i] = -1;
+      fRecord.D2[i] = -1;
     }
     else
     {
-      itDaughterMap = fDaughterMap.find(candidate->D1);
+      itDaughterMap = fDaughterMap.find(fRecord.D1[i]);
       if(itDaughterMap == fDaughterMap.end())
       {
-        candidate->D1 = -1;
-        candidate->D2 = -1;
+        fRecord.D1[i] = -1;
+        fRecord.D2[i] = -1;
       }
       else
       {
-        candidate->D1 = itDaughterMap->second.first;
-        candidate->D2 = itDaughterMap->second.second;
+        fRecord.D1[i] = itDaughterMap->second.first;
+        fRecord.D2[i] = itDaughterMap->second.second;
       }
     }
   }
@@ -32,13 +32,15 @@
 
 #include <stdio.h>
 
+#include "classes/DelphesReader.h"
+#include "classes/DelphesEventRecord.h"
+
 class TObjArray;
 class TStopwatch;
-class TDatabasePDG;
 class ExRootTreeBranch;
 class DelphesFactory;
 
-class DelphesHepMCReader
+class DelphesHepMCReader: public DelphesReader
 {
 public:
 
@@ -55,24 +57,26 @@ public:
     TObjArray *stableParticleOutputArray,
     TObjArray *partonOutputArray);
 
+  bool ReadEvent(DelphesEventRecord &record);
+
   void AnalyzeEvent(ExRootTreeBranch *branch, long long eventNumber,
     TStopwatch *readStopWatch, TStopwatch *procStopWatch);
 
+  void AnalyzeEvent(ExRootTreeBranch *branch, const DelphesEventRecord &record,
+    long long eventNumber, TStopwatch *readStopWatch, TStopwatch *procStopWatch);
+
 private:
 
-  void AnalyzeParticle(DelphesFactory *factory,
-    TObjArray *allParticleOutputArray,
-    TObjArray *stableParticleOutputArray,
-    TObjArray *partonOutputArray);
+  bool ReadBlock();
+
+  void AnalyzeParticle();
 
-  void FinalizeParticles(TObjArray *allParticleOutputArray);
+  void FinalizeParticles();
 
   FILE *fInputFile;
 
   char *fBuffer;
 
-  TDatabasePDG *fPDG;
-
   int fEventNumber, fMPI, fProcessID, fSignalCode, fVertexCounter, fBeamCode[2];
   double fScale, fAlphaQCD, fAlphaQED;
 
@@ -97,6 +101,8 @@ private:
 
   std::map< int, std::pair < int, int > > fMotherMap;
   std::map< int, std::pair < int, int > > fDaughterMap;
+
+  DelphesEventRecord fRecord;
 };
 
 #endif // DelphesHepMCReader_h
@@ -35,8 +35,6 @@
 
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "classes/DelphesClasses.h"
@@ -52,12 +50,10 @@ static const int kBufferSize  = 1024;
 //---------------------------------------------------------------------------
 
 DelphesLHEFReader::DelphesLHEFReader() :
-  fInputFile(0), fBuffer(0), fPDG(0),
+  fInputFile(0), fBuffer(0),
   fEventReady(kFALSE), fEventCounter(-1), fParticleCounter(-1)
 {
   fBuffer = new char[kBufferSize];
-
-  fPDG = TDatabasePDG::Instance();
 }
 
 //---------------------------------------------------------------------------
@@ -81,7 +77,7 @@ void DelphesLHEFReader::Clear()
   fEventReady = kFALSE;
   fEventCounter = -1;
   fParticleCounter = -1;
-  fWeightList.clear();
+  fRecord.Clear();
 }
 
 //---------------------------------------------------------------------------
@@ -97,6 +93,45 @@ bool DelphesLHEFReader::ReadBlock(DelphesFactory *factory,
   TObjArray *allParticleOutputArray,
   TObjArray *stableParticleOutputArray,
   TObjArray *partonOutputArray)
+{
+  if(!ReadBlock()) return kFALSE;
+
+  if(EventReady())
+  {
+    fRecord.Materialize(factory, allParticleOutputArray,
+      stableParticleOutputArray, partonOutputArray);
+  }
+
+  return kTRUE;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesLHEFReader::ReadEvent(DelphesEventRecord &record)
+{
+  long long offset;
+
+  Clear();
+
+  offset = ftello(fInputFile);
+
+  while(ReadBlock())
+  {
+    if(EventReady())
+    {
+      fRecord.Offset = offset;
+      record.Swap(fRecord);
+      Clear();
+      return kTRUE;
+    }
+  }
+
+  return kFALSE;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesLHEFReader::ReadBlock()
 {
   int rc, id;
   char *pch;
@@ -150,8 +185,7 @@ bool DelphesLHEFReader::ReadBlock(DelphesFactory *factory,
       return kFALSE;
     }
 
-    AnalyzeParticle(factory, allParticleOutputArray,
-      stableParticleOutputArray, partonOutputArray);
+    AnalyzeParticle();
 
     --fParticleCounter;
   }
@@ -183,11 +217,17 @@ bool DelphesLHEFReader::ReadBlock(DelphesFactory *factory,
       return kFALSE;
     }
 
-    fWeightList.push_back(make_pair(id, weight));
+    fRecord.WeightList.push_back(make_pair(id, weight));
   }
   else if(strstr(fBuffer, "</event>"))
   {
     fEventReady = kTRUE;
+
+    fRecord.ProcessID = fProcessID;
+    fRecord.Weight = fWeight;
+    fRecord.ScalePDF = fScalePDF;
+    fRecord.AlphaQED = fAlphaQED;
+    fRecord.AlphaQCD = fAlphaQCD;
   }
 
   return kTRUE;
@@ -197,17 +237,25 @@ bool DelphesLHEFReader::ReadBlock(DelphesFactory *factory,
 
 void DelphesLHEFReader::AnalyzeEvent(ExRootTreeBranch *branch, long long eventNumber,
   TStopwatch *readStopWatch, TStopwatch *procStopWatch)
+{
+  AnalyzeEvent(branch, fRecord, eventNumber, readStopWatch, procStopWatch);
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesLHEFReader::AnalyzeEvent(ExRootTreeBranch *branch, const DelphesEventRecord &record,
+  long long eventNumber, TStopwatch *readStopWatch, TStopwatch *procStopWatch)
 {
   LHEFEvent *element;
 
   element = static_cast<LHEFEvent *>(branch->NewEntry());
   element->Number = eventNumber;
 
-  element->ProcessID = fProcessID;
-  element->Weight = fWeight;
-  element->ScalePDF = fScalePDF;
-  element->AlphaQED = fAlphaQED;
-  element->AlphaQCD = fAlphaQCD;
+  element->ProcessID = record.ProcessID;
+  element->Weight = record.Weight;
+  element->ScalePDF = record.ScalePDF;
+  element->AlphaQED = record.AlphaQED;
+  element->AlphaQCD = record.AlphaQCD;
 
   element->ReadTime = readStopWatch->RealTime();
   element->ProcTime = procStopWatch->RealTime();
@@ -216,11 +264,18 @@ void DelphesLHEFReader::AnalyzeEvent(ExRootTreeBranch *branch, long long eventNu
 //---------------------------------------------------------------------------
 
 void DelphesLHEFReader::AnalyzeWeight(ExRootTreeBranch *branch)
+{
+  AnalyzeWeight(branch, fRecord);
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesLHEFReader::AnalyzeWeight(ExRootTreeBranch *branch, const DelphesEventRecord &record)
 {
   LHEFWeight *element;
   vector< pair< int, double > >::const_iterator itWeightList;
 
-  for(itWeightList = fWeightList.begin(); itWeightList != fWeightList.end(); ++itWeightList)
+  for(itWeightList = record.WeightList.begin(); itWeightList != record.WeightList.end(); ++itWeightList)
   {
     element = static_cast<LHEFWeight *>(branch->NewEntry());
 
@@ -231,47 +286,10 @@ void DelphesLHEFReader::AnalyzeWeight(ExRootTreeBranch *branch)
 
 //---------------------------------------------------------------------------
 
-void DelphesLHEFReader::AnalyzeParticle(DelphesFactory *factory,
-  TObjArray *allParticleOutputArray,
-  TObjArray *stableParticleOutputArray,
-  TObjArray *partonOutputArray)
+void DelphesLHEFReader::AnalyzeParticle()
 {
-  Candidate *candidate;
-  TParticlePDG *pdgParticle;
-  int pdgCode;
-
-  candidate = factory->NewCandidate();
-
-  candidate->PID = fPID;
-  pdgCode = TMath::Abs(candidate->PID);
-
-  candidate->Status = fStatus;
-
-  pdgParticle = fPDG->GetParticle(fPID);
-  candidate->Charge = pdgParticle ? int(pdgParticle->Charge()/3.0) : -999;
-  candidate->Mass = fMass;
-
-  candidate->Momentum.SetPxPyPzE(fPx, fPy, fPz, fE);
-  candidate->Position.SetXYZT(0.0, 0.0, 0.0, 0.0);
-
-  candidate->M1 = fM1 - 1;
-  candidate->M2 = fM2 - 1;
-
-  candidate->D1 = -1;
-  candidate->D2 = -1;
-
-  allParticleOutputArray->Add(candidate);
-
-  if(!pdgParticle) return;
-
-  if(fStatus == 1 && pdgParticle->Stable())
-  {
-    stableParticleOutputArray->Add(candidate);
-  }
-  else if(pdgCode <= 5 || pdgCode == 21 || pdgCode == 15)
-  {
-    partonOutputArray->Add(candidate);
-  }
+  fRecord.AddParticle(fPID, fStatus, fM1 - 1, fM2 - 1, -1, -1,
+    fPx, fPy, fPz, fE, fMass, 0.0, 0.0, 0.0, 0.0);
 }
 
 //---------------------------------------------------------------------------
@@ -32,13 +32,15 @@
 #include <vector>
 #include <utility>
 
+#include "classes/DelphesReader.h"
+#include "classes/DelphesEventRecord.h"
+
 class TObjArray;
 class TStopwatch;
-class TDatabasePDG;
 class ExRootTreeBranch;
 class DelphesFactory;
 
-class DelphesLHEFReader
+class DelphesLHEFReader: public DelphesReader
 {
 public:
 
@@ -55,24 +57,28 @@ public:
     TObjArray *stableParticleOutputArray,
     TObjArray *partonOutputArray);
 
+  bool ReadEvent(DelphesEventRecord &record);
+
   void AnalyzeEvent(ExRootTreeBranch *branch, long long eventNumber,
     TStopwatch *readStopWatch, TStopwatch *procStopWatch);
 
+  void AnalyzeEvent(ExRootTreeBranch *branch, const DelphesEventRecord &record,
+    long long eventNumber, TStopwatch *readStopWatch, TStopwatch *procStopWatch);
+
   void AnalyzeWeight(ExRootTreeBranch *branch);
 
+  void AnalyzeWeight(ExRootTreeBranch *branch, const DelphesEventRecord &record);
+
 private:
 
-  void AnalyzeParticle(DelphesFactory *factory,
-    TObjArray *allParticleOutputArray,
-    TObjArray *stableParticleOutputArray,
-    TObjArray *partonOutputArray);
+  bool ReadBlock();
+
+  void AnalyzeParticle();
 
   FILE *fInputFile;
 
   char *fBuffer;
 
-  TDatabasePDG *fPDG;
-
   bool fEventReady;
 
   int fEventCounter;
@@ -82,8 +88,8 @@ private:
 
   int fPID, fStatus, fM1, fM2, fC1, fC2;
   double fPx, fPy, fPz, fE, fMass;
-  
-  std::vector< std::pair< int, double > > fWeightList;
+
+  DelphesEventRecord fRecord;
 };
 
 #endif // DelphesLHEFReader_h
@@ -51,6 +51,8 @@ public:
   virtual void Process();
   virtual void Finish();
 
+  // the arrays can be walked with DelphesArrayView (classes/DelphesArrayView.h),
+  // they keep their storage from one event to the next
   TObjArray *ImportArray(const char *name);
   TObjArray *ExportArray(const char *name);
 
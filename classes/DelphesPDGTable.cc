@@ -0,0 +1,127 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \class DelphesPDGTable
+ *
+ *  Copy of the charge, mass and stability of the TDatabasePDG particles
+ *  in flat arrays: codes with |pid| < kDenseSize are looked up directly,
+ *  the other codes in an open-addressed hash table. It is filled once
+ *  and is read-only afterwards, so it can be shared between threads.
+ *
+ */
+
+#include "classes/DelphesPDGTable.h"
+
+#include "TDatabasePDG.h"
+#include "TParticlePDG.h"
+#include "THashList.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+const DelphesPDGTable &DelphesPDGTable::Instance()
+{
+  static const DelphesPDGTable table;
+  return table;
+}
+
+//---------------------------------------------------------------------------
+
+DelphesPDGTable::DelphesPDGTable() :
+  fSparseMask(0)
+{
+  TDatabasePDG *pdg = TDatabasePDG::Instance();
+  TParticlePDG *pdgParticle;
+  Entry entry;
+  unsigned int size;
+  int pid;
+
+  // GetParticle reads the particle table if it is not loaded yet
+  pdg->GetParticle(211);
+
+  const THashList *list = pdg->ParticleList();
+
+  entry.Mass = 0.0;
+  entry.Charge = 0;
+  entry.Stable = false;
+  entry.Valid = false;
+
+  fDense.assign(2*kDenseSize, entry);
+
+  // at most half of the hash table is used
+  size = 16;
+  while(list && size < 2*unsigned(list->GetSize())) size *= 2;
+
+  fSparseKeys.assign(size, 0);
+  fSparseEntries.assign(size, entry);
+  fSparseMask = size - 1;
+
+  if(!list) return;
+
+  TIter itParticles(list);
+  while((pdgParticle = static_cast<TParticlePDG *>(itParticles.Next())))
+  {
+    pid = pdgParticle->PdgCode();
+    if(pid == 0) continue;
+
+    entry.Mass = pdgParticle->Mass();
+    entry.Charge = int(pdgParticle->Charge()/3.0);
+    entry.Stable = pdgParticle->Stable();
+    entry.Valid = true;
+
+    Insert(pid, entry);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesPDGTable::Insert(int pid, const Entry &entry)
+{
+  unsigned int i;
+
+  if(pid > -kDenseSize && pid < kDenseSize)
+  {
+    fDense[pid + kDenseSize] = entry;
+    return;
+  }
+
+  i = unsigned(pid)*2654435761U & fSparseMask;
+  while(fSparseKeys[i] != 0 && fSparseKeys[i] != pid) i = (i + 1) & fSparseMask;
+
+  fSparseKeys[i] = pid;
+  fSparseEntries[i] = entry;
+}
+
+//---------------------------------------------------------------------------
+
+const DelphesPDGTable::Entry *DelphesPDGTable::FindSparse(int pid) const
+{
+  unsigned int i;
+
+  i = unsigned(pid)*2654435761U & fSparseMask;
+  while(fSparseKeys[i] != 0)
+  {
+    if(fSparseKeys[i] == pid) return &fSparseEntries[i];
+    i = (i + 1) & fSparseMask;
+  }
+
+  return 0;
+}
+
+//---------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesPDGTable_h
+#define DelphesPDGTable_h
+
+/** \class DelphesPDGTable
+ *
+ *  Copy of the charge, mass and stability of the TDatabasePDG particles
+ *  in flat arrays: codes with |pid| < kDenseSize are looked up directly,
+ *  the other codes in an open-addressed hash table. It is filled once
+ *  and is read-only afterwards, so it can be shared between threads.
+ *
+ */
+
+#include <vector>
+
+class DelphesPDGTable
+{
+public:
+
+  struct Entry
+  {
+    double Mass;
+    int Charge; // in units of e, as int(TParticlePDG::Charge()/3)
+    bool Stable;
+    bool Valid;
+  };
+
+  // table built from TDatabasePDG on first use
+  static const DelphesPDGTable &Instance();
+
+  // returns 0 for codes that are not in TDatabasePDG
+  const Entry *GetEntry(int pid) const
+  {
+    if(pid > -kDenseSize && pid < kDenseSize)
+    {
+      const Entry &entry = fDense[pid + kDenseSize];
+      return entry.Valid ? &entry : 0;
+    }
+    return FindSparse(pid);
+  }
+
+  int GetCharge(int pid, int invalid = -999) const
+  {
+    const Entry *entry = GetEntry(pid);
+    return entry ? entry->Charge : invalid;
+  }
+
+  double GetMass(int pid, double invalid = -999.9) const
+  {
+    const Entry *entry = GetEntry(pid);
+    return entry ? entry->Mass : invalid;
+  }
+
+private:
+
+  enum { kDenseSize = 10000 };
+
+  DelphesPDGTable();
+
+  void Insert(int pid, const Entry &entry);
+
+  const Entry *FindSparse(int pid) const;
+
+  std::vector< Entry > fDense;
+
+  std::vector< int > fSparseKeys;
+  std::vector< Entry > fSparseEntries;
+  unsigned int fSparseMask;
+};
+
+#endif // DelphesPDGTable_h
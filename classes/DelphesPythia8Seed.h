@@ -0,0 +1,40 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesPythia8Seed_h
+#define DelphesPythia8Seed_h
+
+/** \class DelphesPythia8Seed
+ *
+ *  Random:seed of one of several Pythia8 instances that read the same
+ *  configuration file and must generate different events.
+ *
+ */
+
+// seed of the given worker from the Random:seed of the configuration:
+// 0 (seed from the clock) stays 0 for every worker, -1 (the Pythia
+// default) is taken as 19780503, and the seed plus the worker number is
+// wrapped within 1 to 900000000 so that it never becomes 0
+inline int GetPythia8WorkerSeed(int seed, int worker)
+{
+  if(seed == 0) return 0;
+  if(seed == -1) seed = 19780503;
+  return 1 + (seed + worker - 1) % 900000000;
+}
+
+#endif // DelphesPythia8Seed_h
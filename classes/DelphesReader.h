@@ -0,0 +1,47 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DelphesReader_h
+#define DelphesReader_h
+
+/** \class DelphesReader
+ *
+ *  Common interface of the generator file readers that decode complete
+ *  events into a DelphesEventRecord
+ *
+ */
+
+#include <stdio.h>
+
+class DelphesEventRecord;
+
+class DelphesReader
+{
+public:
+
+  virtual ~DelphesReader() {}
+
+  virtual void SetInputFile(FILE *inputFile) = 0;
+
+  virtual void Clear() = 0;
+
+  // decodes the next event into record, returns false at the end of the input
+  virtual bool ReadEvent(DelphesEventRecord &record) = 0;
+};
+
+#endif // DelphesReader_h
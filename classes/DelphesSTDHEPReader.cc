@@ -38,8 +38,6 @@
 
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "classes/DelphesClasses.h"
@@ -54,12 +52,10 @@ static const int kBufferSize  = 1000000;
 //---------------------------------------------------------------------------
 
 DelphesSTDHEPReader::DelphesSTDHEPReader() :
-  fInputFile(0), fInputXDR(0), fBuffer(0), fPDG(0), fBlockType(-1)
+  fInputFile(0), fInputXDR(0), fBuffer(0), fBlockType(-1)
 {
   fInputXDR = new XDR;
   fBuffer = new char[kBufferSize*96 + 24];
-
-  fPDG = TDatabasePDG::Instance();
 }
 
 //---------------------------------------------------------------------------
@@ -83,6 +79,7 @@ void DelphesSTDHEPReader::SetInputFile(FILE *inputFile)
 void DelphesSTDHEPReader::Clear()
 {
   fBlockType = -1;
+  fRecord.Clear();
 }
 
 //---------------------------------------------------------------------------
@@ -98,10 +95,49 @@ bool DelphesSTDHEPReader::ReadBlock(DelphesFactory *factory,
   TObjArray *allParticleOutputArray,
   TObjArray *stableParticleOutputArray,
   TObjArray *partonOutputArray)
+{
+  if(!ReadBlock()) return kFALSE;
+
+  if(EventReady())
+  {
+    fRecord.Materialize(factory, allParticleOutputArray,
+      stableParticleOutputArray, partonOutputArray);
+  }
+
+  return kTRUE;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesSTDHEPReader::ReadEvent(DelphesEventRecord &record)
+{
+  long long offset;
+
+  Clear();
+
+  offset = ftello(fInputFile);
+
+  while(ReadBlock())
+  {
+    if(EventReady())
+    {
+      fRecord.Offset = offset;
+      record.Swap(fRecord);
+      Clear();
+      return kTRUE;
+    }
+  }
+
+  return kFALSE;
+}
+
+//---------------------------------------------------------------------------
+
+bool DelphesSTDHEPReader::ReadBlock()
 {
   if(feof(fInputFile)) return kFALSE;
 
-  xdr_int(fInputXDR, &fBlockType);
+  if(!xdr_int(fInputXDR, &fBlockType)) return kFALSE;
 
   SkipBytes(4);
 
@@ -125,14 +161,12 @@ bool DelphesSTDHEPReader::ReadBlock(DelphesFactory *factory,
   else if(fBlockType == MCFIO_STDHEP)
   {
     ReadSTDHEP();
-    AnalyzeParticles(factory, allParticleOutputArray,
-      stableParticleOutputArray, partonOutputArray);
+    AnalyzeParticles();
   }
   else if(fBlockType == MCFIO_STDHEP4)
   {
     ReadSTDHEP();
-    AnalyzeParticles(factory, allParticleOutputArray,
-      stableParticleOutputArray, partonOutputArray);
+    AnalyzeParticles();
     ReadSTDHEP4();
   }
   else
@@ -140,6 +174,15 @@ bool DelphesSTDHEPReader::ReadBlock(DelphesFactory *factory,
     throw runtime_error("Unsupported block type.");
   }
 
+  if(EventReady())
+  {
+    fRecord.Number = fEventNumber;
+    fRecord.Weight = fWeight;
+    fRecord.ScalePDF = fScale[0];
+    fRecord.AlphaQED = fAlphaQED;
+    fRecord.AlphaQCD = fAlphaQCD;
+  }
+
   return kTRUE;
 }
 
@@ -419,19 +462,27 @@ void DelphesSTDHEPReader::ReadSTDHEP4()
 
 void DelphesSTDHEPReader::AnalyzeEvent(ExRootTreeBranch *branch, long long eventNumber,
   TStopwatch *readStopWatch, TStopwatch *procStopWatch)
+{
+  AnalyzeEvent(branch, fRecord, eventNumber, readStopWatch, procStopWatch);
+}
+
+//---------------------------------------------------------------------------
+
+void DelphesSTDHEPReader::AnalyzeEvent(ExRootTreeBranch *branch, const DelphesEventRecord &record,
+  long long eventNumber, TStopwatch *readStopWatch, TStopwatch *procStopWatch)
 {
   LHEFEvent *element;
 
   element = static_cast<LHEFEvent *>(branch->NewEntry());
 
-  element->Number = fEventNumber;
+  element->Number = record.Number;
 
   element->ProcessID = 0;
 
-  element->Weight = fWeight;
-  element->ScalePDF = fScale[0];
-  element->AlphaQED = fAlphaQED;
-  element->AlphaQCD = fAlphaQCD;
+  element->Weight = record.Weight;
+  element->ScalePDF = record.ScalePDF;
+  element->AlphaQED = record.AlphaQED;
+  element->AlphaQCD = record.AlphaQCD;
 
   element->ReadTime = readStopWatch->RealTime();
   element->ProcTime = procStopWatch->RealTime();
@@ -439,15 +490,8 @@ void DelphesSTDHEPReader::AnalyzeEvent(ExRootTreeBranch *branch, long long event
 
 //---------------------------------------------------------------------------
 
-void DelphesSTDHEPReader::AnalyzeParticles(DelphesFactory *factory,
-  TObjArray *allParticleOutputArray,
-  TObjArray *stableParticleOutputArray,
-  TObjArray *partonOutputArray)
+void DelphesSTDHEPReader::AnalyzeParticles()
 {
-  Candidate *candidate;
-  TParticlePDG *pdgParticle;
-  int pdgCode;
-
   int number;
   int pid, status, m1, m2, d1, d2;
   double px, py, pz, e, mass;
@@ -481,39 +525,8 @@ void DelphesSTDHEPReader::AnalyzeParticles(DelphesFactory *factory,
     xdr_double(&bufferXDR[5], &z);
     xdr_double(&bufferXDR[5], &t);
 
-    candidate = factory->NewCandidate();
-
-    candidate->PID = pid;
-    pdgCode = TMath::Abs(candidate->PID);
-
-    candidate->Status = status;
-
-    candidate->M1 = m1 - 1;
-    candidate->M2 = m2 - 1;
-
-    candidate->D1 = d1 - 1;
-    candidate->D2 = d2 - 1;
-
-    pdgParticle = fPDG->GetParticle(pid);
-    candidate->Charge = pdgParticle ? int(pdgParticle->Charge()/3.0) : -999;
-    candidate->Mass = mass;
-
-    candidate->Momentum.SetPxPyPzE(px, py, pz, e);
-
-    candidate->Position.SetXYZT(x, y, z, t);
-
-    allParticleOutputArray->Add(candidate);
-
-    if(!pdgParticle) continue;
-
-    if(status == 1 && pdgParticle->Stable())
-    {
-      stableParticleOutputArray->Add(candidate);
-    }
-    else if(pdgCode <= 5 || pdgCode == 21 || pdgCode == 15)
-    {
-      partonOutputArray->Add(candidate);
-    }
+    fRecord.AddParticle(pid, status, m1 - 1, m2 - 1, d1 - 1, d2 - 1,
+      px, py, pz, e, mass, x, y, z, t);
   }
 }
 
@@ -31,13 +31,15 @@
 #include <rpc/types.h>
 #include <rpc/xdr.h>
 
+#include "classes/DelphesReader.h"
+#include "classes/DelphesEventRecord.h"
+
 class TObjArray;
 class TStopwatch;
-class TDatabasePDG;
 class ExRootTreeBranch;
 class DelphesFactory;
 
-class DelphesSTDHEPReader
+class DelphesSTDHEPReader: public DelphesReader
 {
 public:
   enum STDHEPBlock
@@ -65,15 +67,19 @@ public:
     TObjArray *stableParticleOutputArray,
     TObjArray *partonOutputArray);
 
+  bool ReadEvent(DelphesEventRecord &record);
+
   void AnalyzeEvent(ExRootTreeBranch *branch, long long eventNumber,
     TStopwatch *readStopWatch, TStopwatch *procStopWatch);
 
+  void AnalyzeEvent(ExRootTreeBranch *branch, const DelphesEventRecord &record,
+    long long eventNumber, TStopwatch *readStopWatch, TStopwatch *procStopWatch);
+
 private:
 
-  void AnalyzeParticles(DelphesFactory *factory,
-    TObjArray *allParticleOutputArray,
-    TObjArray *stableParticleOutputArray,
-    TObjArray *partonOutputArray);
+  bool ReadBlock();
+
+  void AnalyzeParticles();
 
   void SkipBytes(u_int size);
   void SkipArray(u_int elsize);
@@ -91,14 +97,14 @@ private:
 
   char *fBuffer;
 
-  TDatabasePDG *fPDG;
-
   u_int fEntries;
   int fBlockType, fEventNumber, fEventSize;
   double fWeight, fAlphaQCD, fAlphaQED;
 
   u_int fScaleSize;
   double fScale[10];
+
+  DelphesEventRecord fRecord;
 };
 
 #endif // DelphesSTDHEPReader_h
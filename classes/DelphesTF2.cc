@@ -20,22 +20,31 @@
 
 #include "RVersion.h"
 #include "TString.h"
+#include "TRandom.h"
+#include "TMath.h"
 
 #include <stdexcept>
+#include <iostream>
 
 using namespace std;
 
 //------------------------------------------------------------------------------
 
 DelphesTF2::DelphesTF2() :
-  TF2()
+  TF2(),
+  fTableNX(0), fTableNY(0),
+  fTableXmin(0), fTableYmin(0), fTableDX(0), fTableDY(0),
+  fBatchIndex(0)
 {
 }
 
 //------------------------------------------------------------------------------
 
 DelphesTF2::DelphesTF2(const char *name, const char *expression) :
-  TF2(name, expression)
+  TF2(name, expression),
+  fTableNX(0), fTableNY(0),
+  fTableXmin(0), fTableYmin(0), fTableDX(0), fTableDY(0),
+  fBatchIndex(0)
 {
 }
 
@@ -70,3 +79,161 @@ Int_t DelphesTF2::Compile(const char *expression)
 }
 
 //------------------------------------------------------------------------------
+
+void DelphesTF2::Tabulate(Int_t nx, Int_t ny)
+{
+  Double_t xmin, ymin, xmax, ymax, value, sum;
+  Int_t i, j, n, small, large;
+  vector< Double_t > weight;
+  vector< Int_t > smallList, largeList;
+
+  if(nx <= 0 || ny <= 0)
+  {
+    throw runtime_error("Invalid number of table bins.");
+  }
+
+  GetRange(xmin, ymin, xmax, ymax);
+
+  fTableProbability.clear();
+  fTableAlias.clear();
+  fBatch.clear();
+  fBatchIndex = 0;
+
+  fTableNX = nx;
+  fTableNY = ny;
+  fTableXmin = xmin;
+  fTableYmin = ymin;
+  fTableDX = (xmax - xmin)/nx;
+  fTableDY = (ymax - ymin)/ny;
+
+  // function value at the centre of each cell
+  n = nx*ny;
+  weight.resize(n);
+  sum = 0.0;
+  for(j = 0; j < ny; ++j)
+  {
+    for(i = 0; i < nx; ++i)
+    {
+      value = Eval(xmin + (i + 0.5)*fTableDX, ymin + (j + 0.5)*fTableDY);
+      // leave the unusual cases to TF2::GetRandom2
+      if(value < 0.0) return;
+      weight[j*nx + i] = value;
+      sum += value;
+    }
+  }
+
+  if(sum <= 0.0) return;
+
+  // build the alias table (Walker's method), each cell is picked with
+  // fTableProbability, otherwise its alias is used
+  fTableProbability.assign(n, 1.0);
+  fTableAlias.resize(n);
+  for(i = 0; i < n; ++i)
+  {
+    fTableAlias[i] = i;
+    weight[i] *= n/sum;
+    if(weight[i] < 1.0)
+      smallList.push_back(i);
+    else
+      largeList.push_back(i);
+  }
+
+  while(!smallList.empty() && !largeList.empty())
+  {
+    small = smallList.back();
+    smallList.pop_back();
+    large = largeList.back();
+    largeList.pop_back();
+
+    fTableProbability[small] = weight[small];
+    fTableAlias[small] = large;
+
+    weight[large] = (weight[large] + weight[small]) - 1.0;
+    if(weight[large] < 1.0)
+      smallList.push_back(large);
+    else
+      largeList.push_back(large);
+  }
+}
+
+//------------------------------------------------------------------------------
+
+void DelphesTF2::FillBatch()
+{
+  const Int_t batchSize = 1024;
+  Int_t n, k, cell;
+  Double_t u;
+
+  // three uniform numbers per draw, the resulting (x, y) pairs are
+  // stored in place of the first two
+  fBatch.resize(3*batchSize);
+  gRandom->RndmArray(3*batchSize, &fBatch[0]);
+
+  n = fTableProbability.size();
+  for(k = 0; k < batchSize; ++k)
+  {
+    u = fBatch[3*k]*n;
+    cell = TMath::Min(Int_t(u), n - 1);
+    if(u - cell >= fTableProbability[cell]) cell = fTableAlias[cell];
+
+    fBatch[2*k] = fTableXmin + (cell % fTableNX + fBatch[3*k + 1])*fTableDX;
+    fBatch[2*k + 1] = fTableYmin + (cell / fTableNX + fBatch[3*k + 2])*fTableDY;
+  }
+  fBatch.resize(2*batchSize);
+  fBatchIndex = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void DelphesTF2::GetTabulatedRandom2(Double_t &x, Double_t &y)
+{
+  if(fTableProbability.empty())
+  {
+    GetRandom2(x, y);
+    return;
+  }
+
+  if(fBatchIndex >= fBatch.size()) FillBatch();
+
+  x = fBatch[fBatchIndex++];
+  y = fBatch[fBatchIndex++];
+}
+
+//------------------------------------------------------------------------------
+
+void DelphesTF2::ValidateTable(Int_t n)
+{
+  Double_t x, y, sum[2][4] = {{0.0}};
+  Int_t i, k;
+
+  if(n <= 0) return;
+
+  for(i = 0; i < n; ++i)
+  {
+    for(k = 0; k < 2; ++k)
+    {
+      if(k == 0)
+        GetTabulatedRandom2(x, y);
+      else
+        GetRandom2(x, y);
+      sum[k][0] += x;
+      sum[k][1] += x*x;
+      sum[k][2] += y;
+      sum[k][3] += y*y;
+    }
+  }
+
+  cout << "** INFO: vertex distribution, " << n << " draws from table / function" << endl;
+  for(k = 0; k < 2; ++k)
+  {
+    for(i = 0; i < 4; ++i) sum[k][i] /= n;
+  }
+  cout << "**   mean z: " << sum[0][0] << " / " << sum[1][0] << endl;
+  cout << "**   RMS  z: " << TMath::Sqrt(TMath::Max(0.0, sum[0][1] - sum[0][0]*sum[0][0]))
+       << " / " << TMath::Sqrt(TMath::Max(0.0, sum[1][1] - sum[1][0]*sum[1][0])) << endl;
+  cout << "**   mean t: " << sum[0][2] << " / " << sum[1][2] << endl;
+  cout << "**   RMS  t: " << TMath::Sqrt(TMath::Max(0.0, sum[0][3] - sum[0][2]*sum[0][2]))
+       << " / " << TMath::Sqrt(TMath::Max(0.0, sum[1][3] - sum[1][2]*sum[1][2])) << endl;
+}
+
+//------------------------------------------------------------------------------
@@ -21,6 +21,8 @@
 
 #include "TF2.h"
 
+#include <vector>
+
 class DelphesTF2: public TF2
 {
 public:
@@ -32,6 +34,30 @@ public:
   ~DelphesTF2();
 
   Int_t Compile(const char *expression);
+
+  // tabulates the function on a nx x ny grid covering the current range
+  void Tabulate(Int_t nx, Int_t ny);
+
+  // draws (x, y) from the table, or with TF2::GetRandom2 if there is none
+  void GetTabulatedRandom2(Double_t &x, Double_t &y);
+
+  // prints the mean and RMS of n draws from the table and from the TF2
+  void ValidateTable(Int_t n);
+
+private:
+
+  void FillBatch();
+
+  Int_t fTableNX, fTableNY;
+  Double_t fTableXmin, fTableYmin, fTableDX, fTableDY;
+
+  // Walker alias table, one entry per grid cell
+  std::vector< Double_t > fTableProbability;
+  std::vector< Int_t > fTableAlias;
+
+  // draws are made in batches
+  std::vector< Double_t > fBatch;
+  size_t fBatchIndex;
 };
 
 #endif /* DelphesTF2_h */
@@ -18,11 +18,12 @@ RaveConverter::RaveConverter(double Bz, double cov_scaling):
 
 rave::Vector6D RaveConverter::getState(const Candidate* cand) {
   using namespace TrackParam;
-  double a_d0 = cand->trkPar[D0];
-  double a_z0 = cand->trkPar[Z0];
-  double a_phi = cand->trkPar[PHI];
-  double a_qoverp = cand->trkPar[QOVERP];
-  double a_theta = cand->trkPar[THETA];
+  const float* par = cand->GetTrackParameters().trkPar;
+  double a_d0 = par[D0];
+  double a_z0 = par[Z0];
+  double a_phi = par[PHI];
+  double a_qoverp = par[QOVERP];
+  double a_theta = par[THETA];
   double a_q = cand->Charge;
 
   // -- translate these to Rave coordinates
@@ -63,11 +64,12 @@ rave::PerigeeCovariance5D RaveConverter::getPerigeeCov(const Candidate* cand) {
   // -- translate to Rave coordinates
   // rave base units are cm and GeV, Delphes takes mm and GeV
   // need to calculate some things for the jacobian
-  const float* par = cand->trkPar;
+  const CandidateTrackParameters& trackParameters = cand->GetTrackParameters();
+  const float* par = trackParameters.trkPar;
   double drdq = getDrhoDqoverp(par[THETA]);
   double drdt = getDrhoDtheta(par[QOVERP], par[THETA]);
 
-  const float* cov0 = cand->trkCov;
+  const float* cov0 = trackParameters.trkCov;
   float cov[15];
   for (size_t iii = 0; iii < 15; iii++) {
     cov[iii] = cov0[iii] * _cov_scaling;
@@ -136,15 +138,28 @@ double RaveConverter::getDrhoDtheta(double qoverp, double theta) {
 std::vector<rave::Track> RaveConverter::getRaveTracks(
   const std::vector<Candidate*>& in) {
   std::vector<rave::Track> tracks;
+  tracks.reserve(in.size());
   for (const auto& deltrack: in) {
-    rave::Vector6D state = getState(deltrack);
-    rave::PerigeeCovariance5D cov5d = getPerigeeCov(deltrack);
-    int charge = deltrack->Charge;
-    rave::Covariance6D cov6d = _to_rave.convert(cov5d, state, charge);
-    rave::Track track(state, cov6d, charge, 0.0, 0.0, deltrack);
-    tracks.push_back(track);
+    tracks.push_back(getRaveTrack(deltrack));
   }
   return tracks;
 }
 
+const rave::Track& RaveConverter::getRaveTrack(Candidate* deltrack) {
+  // the primary vertex and the jets share most of their tracks
+  auto cached = _track_cache.find(deltrack->GetUniqueID());
+  if (cached != _track_cache.end()) return cached->second;
+
+  rave::Vector6D state = getState(deltrack);
+  rave::PerigeeCovariance5D cov5d = getPerigeeCov(deltrack);
+  int charge = deltrack->Charge;
+  rave::Covariance6D cov6d = _to_rave.convert(cov5d, state, charge);
+  rave::Track track(state, cov6d, charge, 0.0, 0.0, deltrack);
+  return _track_cache.emplace(deltrack->GetUniqueID(), track).first->second;
+}
+
+void RaveConverter::clearCache() {
+  _track_cache.clear();
+}
+
 #endif // NO_RAVE
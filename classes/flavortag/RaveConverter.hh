@@ -8,6 +8,7 @@
 #include "RaveBase/Converters/interface/RaveToPerigeeObjects.h"
 
 #include <vector>
+#include <unordered_map>
 
 class Candidate;
 
@@ -17,6 +18,10 @@ class RaveConverter
 public:
   RaveConverter(double Bz, double cov_scaling = 1);
   std::vector<rave::Track> getRaveTracks(const std::vector<Candidate*>& in);
+  // converted tracks are cached by candidate unique ID until the next
+  // call to clearCache, which should be done at the start of each event
+  const rave::Track& getRaveTrack(Candidate* in);
+  void clearCache();
   rave::Point3D getSeed(const std::vector<Candidate*>& in);
 private:
   rave::Vector6D getState(const Candidate*);
@@ -30,6 +35,7 @@ private:
   double _cov_scaling;
   rave::PerigeeToRaveObjects _to_rave;
   rave::RaveToPerigeeObjects _to_perigee;
+  std::unordered_map<unsigned, rave::Track> _track_cache;
 };
 
 #endif
@@ -33,6 +33,24 @@ namespace {
   // see hardcoded parameters in constants_jetprob.hh
   double get_track_prob(double d0sig);
 
+  // derivative of get_track_prob
+  double get_track_prob_derivative(double d0sig);
+
+  // get_track_prob tabulated in |d0 significance| with its derivative,
+  // cubic Hermite interpolation inside the table and direct evaluation
+  // beyond it
+  class TrackProbTable
+  {
+  public:
+    TrackProbTable();
+    double operator()(double sig) const;
+  private:
+    // value and derivative times the step, for each node
+    std::vector<std::pair<double, double> > m_nodes;
+    double m_scale;
+  };
+  const TrackProbTable& track_prob_table();
+
   typedef std::pair<double, double> JetWidth;
   JetWidth jet_width2_eta_phi(const TVector3& jet, const Tracks& tracks);
 
@@ -139,7 +157,7 @@ void HighLevelTracking::fill(const TVector3& jet,
   // size_t n_tracks = pars.size();
   double jet_phi = jet.Phi();
   assert(std::abs(jet_phi) <= pi);
-  std::vector<std::pair<double, TrackParameters> > tracks_by_ip;
+  std::vector<std::pair<double, size_t> > tracks_by_ip;
 
   // zero some things
   track2d0sig = -inf;
@@ -163,26 +181,29 @@ void HighLevelTracking::fill(const TVector3& jet,
   // what follows uses numbered tracks (track counting)
   if (pars.size() < 2) return;
 
-  for (const auto& par: pars) {
+  // sort the signed impact parameters with the index of their track
+  tracks_by_ip.reserve(pars.size());
+  for (size_t trkn = 0; trkn < pars.size(); trkn++) {
+    const auto& par = pars[trkn];
     double diff = std::abs(jet_phi - par.phi);
     int sign = (diff > 3*pi/4 || diff < pi/2) ? 1 : -1;
     double ip = std::copysign(par.d0, sign);
-    tracks_by_ip.emplace_back(ip, par);
+    tracks_by_ip.emplace_back(ip, trkn);
     if ((ip / par.d0err) > ip_threshold) tracksOverIpThreshold++;
   }
 
   std::sort(tracks_by_ip.begin(), tracks_by_ip.end(),
-	    by_descending_first<TrackParameters>);
+	    by_descending_first<size_t>);
   {
     const auto& trk2 = tracks_by_ip.at(1);
-    const auto& p2 = trk2.second;
+    const auto& p2 = pars[trk2.second];
     track2d0sig = std::copysign(p2.d0 / p2.d0err, trk2.first);
     track2z0sig = std::abs(p2.z0 / p2.z0err);
   }
   if (tracks_by_ip.size() < 3) return;
   {
     const auto& trk3 = tracks_by_ip.at(2);
-    const auto& p3 = trk3.second;
+    const auto& p3 = pars[trk3.second];
     track3d0sig = std::copysign(p3.d0 / p3.d0err, trk3.first);
     track3z0sig = std::abs(p3.z0 / p3.z0err);
   }
@@ -217,17 +238,62 @@ namespace {
       exp_prob(sig, P4, P5) + exp_prob(sig, P6, P7);
     return prob;
   }
+  double gauss_prob_derivative(double sig, const double norm,
+			       const double width) {
+    const double sq2 = std::sqrt(2);
+    return -norm / sq2 * std::exp(-sig*sig / (2 * width*width));
+  }
+  double exp_prob_derivative(double sig, const double off, const double mult) {
+    return -std::exp(-off - mult*sig);
+  }
+  double get_track_prob_derivative(double sig) {
+    using namespace jetprob;
+    return gauss_prob_derivative(sig, P0, P1) +
+      gauss_prob_derivative(sig, P2, P3) +
+      exp_prob_derivative(sig, P4, P5) + exp_prob_derivative(sig, P6, P7);
+  }
+  TrackProbTable::TrackProbTable():
+    m_nodes(2001), m_scale(50)
+  {
+    // steps of 0.02 up to a significance of 40
+    for (size_t bin = 0; bin < m_nodes.size(); bin++) {
+      double sig = bin / m_scale;
+      m_nodes[bin].first = get_track_prob(sig);
+      m_nodes[bin].second = get_track_prob_derivative(sig) / m_scale;
+    }
+  }
+  double TrackProbTable::operator()(double sig) const {
+    double pos = sig * m_scale;
+    // also catches NaN
+    if (!(pos >= 0 && pos < m_nodes.size() - 1)) return get_track_prob(sig);
+    size_t bin = pos;
+    double t = pos - bin;
+    const auto& n0 = m_nodes[bin];
+    const auto& n1 = m_nodes[bin + 1];
+    double t2 = t*t;
+    double t3 = t2*t;
+    return (2*t3 - 3*t2 + 1) * n0.first + (t3 - 2*t2 + t) * n0.second +
+      (3*t2 - 2*t3) * n1.first + (t3 - t2) * n1.second;
+  }
+  const TrackProbTable& track_prob_table() {
+    static const TrackProbTable table;
+    return table;
+  }
   double get_jet_prob(const std::vector<TrackParameters>& pars) {
+    const TrackProbTable& track_prob = track_prob_table();
     double p0 = 1.0;
     for (const auto& par: pars) {
       double sig = par.d0 / par.d0err;
-      double prob = get_track_prob(std::abs(sig));
-      p0 *= prob;
+      p0 *= track_prob(std::abs(sig));
     }
+    // sum of (-log p0)^k / k! for k < n_trk, each term from the previous
     int n_trk = pars.size();
+    double log_p0 = -std::log(p0);
+    double term = 1;
     double corrections = 0;
     for (int k = 0; k < n_trk; k++) {
-      corrections += std::pow( -std::log(p0), k) / std::tgamma(k + 1);
+      if (k > 0) term *= log_p0 / k;
+      corrections += term;
     }
     return p0 * corrections;
   }
@@ -243,7 +309,8 @@ namespace {
       double eta = -std::log(std::tan(trk.theta/2));
       double deta = eta - jet_eta;
       double dphi = phi_mpi_pi(trk.phi, jet_phi);
-      double track_pt = std::abs(1 / (trk.qoverp * std::cosh(eta)));
+      // 1 / cosh(eta) is sin(theta)
+      double track_pt = std::abs(std::sin(trk.theta) / trk.qoverp);
       sum_pt += track_pt;
       sum_pt_times_eta2 += track_pt * deta*deta;
       sum_pt_times_phi2 += track_pt * dphi*dphi;
@@ -34,13 +34,12 @@
 #include "TFile.h"
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "classes/DelphesStream.h"
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesPDGTable.h"
 #include "classes/DelphesPileUpReader.h"
 
 #include "ExRootAnalysis/ExRootTreeWriter.h"
@@ -57,8 +56,8 @@ void ProcessEvent(DelphesPileUpReader *reader, ExRootTreeBranch *branch)
   Int_t pid;
   Float_t x, y, z, t;
   Float_t px, py, pz, e;
-  TDatabasePDG *pdg = TDatabasePDG::Instance();
-  TParticlePDG *pdgParticle;
+  const DelphesPDGTable *pdg = &DelphesPDGTable::Instance();
+  const DelphesPDGTable::Entry *pdgParticle;
   TLorentzVector momentum;
   Double_t pt, signPz, cosTheta, eta, rapidity;
 
@@ -85,10 +84,10 @@ void ProcessEvent(DelphesPileUpReader *reader, ExRootTreeBranch *branch)
     particle->D1 = -1;
     particle->D2 = -1;
 
-    pdgParticle = pdg->GetParticle(pid);
-    particle->Charge = pdgParticle ? Int_t(pdgParticle->Charge()/3.0) : -999;
+    pdgParticle = pdg->GetEntry(pid);
+    particle->Charge = pdgParticle ? pdgParticle->Charge : -999;
 
-    particle->Mass = pdgParticle ? pdgParticle->Mass() : -999.9;
+    particle->Mass = pdgParticle ? pdgParticle->Mass : -999.9;
 
     momentum.SetPxPyPzE(px, py, pz, e);
     pt = momentum.Pt();
@@ -278,7 +278,7 @@ all:
 
 executableDeps {converters/*.cpp} {examples/*.cpp}
 
-executableDeps {readers/DelphesHepMC.cpp} {readers/DelphesLHEF.cpp} {readers/DelphesSTDHEP.cpp}
+executableDeps {readers/DelphesBench.cpp} {readers/DelphesHepMC.cpp} {readers/DelphesLHEF.cpp} {readers/DelphesParallel.cpp} {readers/DelphesSTDHEP.cpp}
 
 puts {ifeq ($(HAS_CMSSW),true)}
 executableDeps {readers/DelphesCMSFWLite.cpp}
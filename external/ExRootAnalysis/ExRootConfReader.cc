@@ -103,6 +103,65 @@ ExRootConfParam ExRootConfReader::GetParam(const char *name)
 
 //------------------------------------------------------------------------------
 
+void ExRootConfReader::SetParam(const char *name, const char *value)
+{
+  stringstream message;
+  TString command, space(name);
+  Ssiz_t last = space.Last(':');
+
+  // make sure that the namespace of the parameter exists
+  if(last > 1 && space[last - 1] == ':')
+  {
+    space.Remove(last - 1);
+    command = "namespace eval ::" + space + " {}";
+    if(Tcl_Eval(fTclInterp, const_cast<char *>(command.Data())) != TCL_OK)
+    {
+      message << "can't create namespace '" << space << "'" << endl;
+      message << Tcl_GetStringResult(fTclInterp);
+      throw runtime_error(message.str());
+    }
+  }
+
+  Tcl_Obj *variableName = Tcl_NewStringObj(const_cast<char *>(name), -1);
+  Tcl_Obj *variableValue = Tcl_NewStringObj(const_cast<char *>(value), -1);
+  if(!Tcl_ObjSetVar2(fTclInterp, variableName, 0, variableValue, TCL_GLOBAL_ONLY | TCL_LEAVE_ERR_MSG))
+  {
+    message << "can't set parameter '" << name << "'" << endl;
+    message << Tcl_GetStringResult(fTclInterp);
+    throw runtime_error(message.str());
+  }
+}
+
+//------------------------------------------------------------------------------
+
+vector<TString> ExRootConfReader::GetModuleParams(const char *moduleName)
+{
+  stringstream message;
+  vector<TString> result;
+  Tcl_Obj **elements;
+  int i, length;
+  TString name, command = TString("info vars ::") + moduleName + "::*";
+
+  if(Tcl_Eval(fTclInterp, const_cast<char *>(command.Data())) != TCL_OK ||
+     Tcl_ListObjGetElements(fTclInterp, Tcl_GetObjResult(fTclInterp), &length, &elements) != TCL_OK)
+  {
+    message << "can't list parameters of module '" << moduleName << "'" << endl;
+    message << Tcl_GetStringResult(fTclInterp);
+    throw runtime_error(message.str());
+  }
+
+  // strip the namespace qualifier from the variable names
+  for(i = 0; i < length; ++i)
+  {
+    name = Tcl_GetStringFromObj(elements[i], 0);
+    result.push_back(name(name.Last(':') + 1, name.Length()));
+  }
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+
 int ExRootConfReader::GetInt(const char *name, int defaultValue, int index)
 {
   ExRootConfParam object = GetParam(name);
@@ -12,6 +12,7 @@
 #include "TNamed.h"
 
 #include <map>
+#include <vector>
 #include <utility>
 #include <ostream>
 
@@ -59,6 +60,9 @@ public:
   const char *GetString(const char *name, const char *defaultValue, int index = -1);
   ExRootConfParam GetParam(const char *name);
 
+  void SetParam(const char *name, const char *value);
+  std::vector<TString> GetModuleParams(const char *moduleName);
+
   const ExRootTaskMap *GetModules() const { return &fModules; }
 
   void AddModule(const char *className, const char *moduleName);
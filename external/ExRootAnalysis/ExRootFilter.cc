@@ -3,6 +3,11 @@
  *
  *  Class simplifying classification and subarrays handling
  *
+ *  Each classifier runs once over the collection after a reset and
+ *  fills the arrays of all its categories in the same pass.
+ *  The arrays are kept from one event to the next and are only
+ *  emptied when the collection is classified again.
+ *
  *  \author P. Demin - UCL, Louvain-la-Neuve
  *
  */
@@ -19,12 +24,10 @@
 
 using namespace std;
 
-typedef map<Int_t, TObjArray*> TCategoryMap;
-typedef map<ExRootClassifier*, pair<Bool_t, TCategoryMap> > TClassifierMap;
-
 ExRootFilter::ExRootFilter(const TSeqCollection *collection) :
-  fCollection(collection)
+  fCollection(collection), fArray(0)
 {
+  fArray = dynamic_cast<const TObjArray *>(fCollection);
   fIter = fCollection->MakeIterator();
 }
 
@@ -32,14 +35,14 @@ ExRootFilter::ExRootFilter(const TSeqCollection *collection) :
 
 ExRootFilter::~ExRootFilter()
 {
-  TClassifierMap::iterator itMap;
-  TCategoryMap::iterator itSubMap;
-  for(itMap = fMap.begin(); itMap != fMap.end(); ++itMap)
+  vector<TPartition>::iterator itPartition;
+  vector<TCategory>::iterator itCategory;
+  for(itPartition = fPartitions.begin(); itPartition != fPartitions.end(); ++itPartition)
   {
-    for(itSubMap = itMap->second.second.begin();
-        itSubMap != itMap->second.second.end(); ++itSubMap)
+    for(itCategory = itPartition->categories.begin();
+        itCategory != itPartition->categories.end(); ++itCategory)
     {
-      delete (itSubMap->second);
+      delete itCategory->array;
     }
   }
 
@@ -50,84 +53,131 @@ ExRootFilter::~ExRootFilter()
 
 void ExRootFilter::Reset(ExRootClassifier *classifier)
 {
-  TClassifierMap::iterator itMap;
-  TCategoryMap::iterator itSubMap;
-  if(classifier)
+  vector<TPartition>::iterator itPartition;
+  for(itPartition = fPartitions.begin(); itPartition != fPartitions.end(); ++itPartition)
   {
-    itMap = fMap.find(classifier);
-    if(itMap != fMap.end())
+    if(!classifier || itPartition->classifier == classifier)
     {
-      itMap->second.first = kTRUE;
-      for(itSubMap = itMap->second.second.begin();
-          itSubMap != itMap->second.second.end(); ++itSubMap)
-      {
-        itSubMap->second->Clear();
-      }
+      itPartition->invalid = kTRUE;
     }
   }
-  else
+}
+
+//------------------------------------------------------------------------------
+
+TObjArray *ExRootFilter::GetSubArray(ExRootClassifier *classifier, Int_t category)
+{
+  TPartition *partition;
+  vector<TCategory>::iterator itCategory;
+
+  partition = GetPartition(classifier);
+
+  if(partition->invalid)
   {
-    for(itMap = fMap.begin(); itMap != fMap.end(); ++itMap)
-    {
-      itMap->second.first = kTRUE;
-      for(itSubMap = itMap->second.second.begin();
-          itSubMap != itMap->second.second.end(); ++itSubMap)
-      {
-        itSubMap->second->Clear();
-      }
-    }
+    partition->invalid = kFALSE;
+    Classify(partition);
   }
+
+  for(itCategory = partition->categories.begin();
+      itCategory != partition->categories.end(); ++itCategory)
+  {
+    if(itCategory->category == category) return itCategory->array;
+  }
+
+  return 0;
 }
 
 //------------------------------------------------------------------------------
 
-TObjArray *ExRootFilter::GetSubArray(ExRootClassifier *classifier, Int_t category)
+ExRootFilter::TPartition *ExRootFilter::GetPartition(ExRootClassifier *classifier)
 {
-  Int_t result;
+  vector<TPartition>::iterator itPartition;
+  TPartition partition;
+
+  for(itPartition = fPartitions.begin(); itPartition != fPartitions.end(); ++itPartition)
+  {
+    if(itPartition->classifier == classifier) return &(*itPartition);
+  }
+
+  partition.classifier = classifier;
+  partition.invalid = kTRUE;
+  fPartitions.push_back(partition);
+
+  return &fPartitions.back();
+}
+
+//------------------------------------------------------------------------------
+
+TObjArray *ExRootFilter::GetCategoryArray(TPartition *partition, Int_t category)
+{
+  vector<TCategory>::iterator itCategory;
+  TCategory newCategory;
+
+  for(itCategory = partition->categories.begin();
+      itCategory != partition->categories.end(); ++itCategory)
+  {
+    if(itCategory->category == category) return itCategory->array;
+  }
+
+  newCategory.category = category;
+  newCategory.array = new TObjArray(fCollection->GetSize());
+  partition->categories.push_back(newCategory);
+
+  return newCategory.array;
+}
+
+//------------------------------------------------------------------------------
+
+void ExRootFilter::Classify(TPartition *partition)
+{
+  Int_t result, lastResult, i, size;
   TObject *element;
   TObjArray *array;
-  TCategoryMap::iterator itSubMap;
-  pair<TCategoryMap::iterator, bool> pairSubMap;
-  pair<TClassifierMap::iterator, bool> pairMap;
+  vector<TCategory>::iterator itCategory;
 
-  TClassifierMap::iterator itMap = fMap.find(classifier);
-  if(itMap == fMap.end())
+  for(itCategory = partition->categories.begin();
+      itCategory != partition->categories.end(); ++itCategory)
   {
-    pairMap = fMap.insert(make_pair(classifier, make_pair(kTRUE, TCategoryMap())));
-    if(!pairMap.second)
+    if(itCategory->array->GetEntriesFast() > 0) itCategory->array->Clear();
+  }
+
+  // consecutive elements often belong to the same category,
+  // remember the last array to skip the category lookup
+  lastResult = -1;
+  array = 0;
+
+  if(fArray)
+  {
+    size = fArray->GetEntriesFast();
+    for(i = 0; i < size; ++i)
     {
-      throw runtime_error("can't insert category map");
+      element = fArray->UncheckedAt(i);
+      if(!element) continue;
+      result = partition->classifier->GetCategory(element);
+      if(result < 0) continue;
+      if(result != lastResult || !array)
+      {
+        array = GetCategoryArray(partition, result);
+        lastResult = result;
+      }
+      array->AddLast(element);
     }
-
-    itMap = pairMap.first;
   }
-
-  if(itMap->second.first)
+  else
   {
-    itMap->second.first = kFALSE;
     fIter->Reset();
     while((element = fIter->Next()) != 0)
     {
-      result = classifier->GetCategory(element);
+      result = partition->classifier->GetCategory(element);
       if(result < 0) continue;
-      itSubMap = itMap->second.second.find(result);
-      if(itSubMap == itMap->second.second.end())
+      if(result != lastResult || !array)
       {
-        array = new TObjArray(fCollection->GetSize());
-        pairSubMap = itMap->second.second.insert(make_pair(result, array));
-        if(!pairSubMap.second)
-        {
-          throw runtime_error("can't insert category");
-        }
-
-        itSubMap = pairSubMap.first;
+        array = GetCategoryArray(partition, result);
+        lastResult = result;
       }
-      itSubMap->second->Add(element);
+      array->AddLast(element);
     }
   }
-
-  itSubMap = itMap->second.second.find(category);
-  return (itSubMap != itMap->second.second.end()) ? itSubMap->second : 0;
 }
 
 //------------------------------------------------------------------------------
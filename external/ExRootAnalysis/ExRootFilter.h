@@ -3,7 +3,7 @@
 
 #include "Rtypes.h"
 
-#include <map>
+#include <vector>
 
 class ExRootClassifier;
 class TSeqCollection;
@@ -23,10 +23,28 @@ public:
 
 private:
 
+  struct TCategory
+  {
+    Int_t category;
+    TObjArray *array;
+  };
+
+  struct TPartition
+  {
+    ExRootClassifier *classifier;
+    Bool_t invalid;
+    std::vector<TCategory> categories;
+  };
+
+  TPartition *GetPartition(ExRootClassifier *classifier);
+  TObjArray *GetCategoryArray(TPartition *partition, Int_t category);
+  void Classify(TPartition *partition);
+
   const TSeqCollection *fCollection; //!
+  const TObjArray *fArray; //!
   TIterator *fIter; //!
 
-  std::map<ExRootClassifier*, std::pair<Bool_t, std::map<Int_t, TObjArray*> > > fMap; //!
+  std::vector<TPartition> fPartitions; //!
 
 };
 
@@ -0,0 +1,159 @@
+// Buffer for fixed-width rows of HDF5 objects.
+//
+// Works like OneDimBuffer, but every entry is a row of `width`
+// objects. Shorter rows are padded with default-constructed (i.e. zero)
+// objects, longer rows are truncated. This is meant for writing
+// per-jet collections as dense (n_jets x width) arrays.
+
+#ifndef TWO_DIM_BUFFER_HH
+#define TWO_DIM_BUFFER_HH
+
+#include "OneDimBuffer.hh"
+
+#include "H5Cpp.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// _________________________________________________________________________
+// public interface
+
+template<typename T>
+class TwoDimBuffer
+{
+public:
+  // Basic constructor.
+  //  - The first argument should be a group or file,
+  //  - the second is the name of this dataset within the file,
+  //  - the third is the ``type'' as seen by HDF5,
+  //  - the fourth is the number of objects in each row.
+  //  - The final entry is the max number of rows in the buffer, it's
+  //    also used as the chunk size along the first dimension.
+  TwoDimBuffer(H5::CommonFG& group, std::string ds_name,
+	       H5::DataType type, hsize_t width, hsize_t buffer_size = 10);
+
+  // Constructor for compound types, which packs the on-disk datatype
+  // (see OneDimBuffer).
+  TwoDimBuffer(H5::CommonFG& group, std::string ds_name,
+	       H5::CompType type, hsize_t width, hsize_t buffer_size = 10);
+
+  TwoDimBuffer(const TwoDimBuffer&) = delete;
+  TwoDimBuffer& operator=(TwoDimBuffer) = delete;
+
+  // add one row, padded or truncated to `width`
+  void push_back(const std::vector<T>& row);
+  // empty the buffer to disk
+  void flush();
+  // get the _total_ number of rows (buffered and written)
+  hsize_t size() const;
+  // close the dataset
+  void close();
+
+// ____________________________________________________________________
+// implementation level stuff
+
+private:
+  TwoDimBuffer(H5::CommonFG& group, std::string ds_name,
+	       H5::DataType type, H5::DataType disk_type,
+	       hsize_t width, hsize_t buffer_size);
+
+  // In-memory datatype
+  H5::DataType _type;
+
+  // number of objects per row
+  hsize_t _width;
+
+  // number of rows where `flush()` is called
+  hsize_t _max_size;
+
+  // keep track of the current row in the disk dataset.
+  hsize_t _offset;
+
+  // buffer of objects in memory, row after row.
+  std::vector<T> _buffer;
+
+  // the dataset we're writing to.
+  H5::DataSet _ds;
+};
+
+template<typename T>
+TwoDimBuffer<T>::TwoDimBuffer(
+  H5::CommonFG& group, std::string ds_name,
+  H5::DataType type, hsize_t width, hsize_t size):
+  TwoDimBuffer(group, ds_name, type, type, width, size)
+{
+}
+template<typename T>
+TwoDimBuffer<T>::TwoDimBuffer(
+  H5::CommonFG& group, std::string ds_name,
+  H5::CompType type, hsize_t width, hsize_t size):
+  TwoDimBuffer(group, ds_name, type, h5::packed(type), width, size)
+{
+}
+
+template<typename T>
+TwoDimBuffer<T>::TwoDimBuffer(
+  H5::CommonFG& group, std::string ds_name,
+  H5::DataType type, H5::DataType disk_type,
+  hsize_t width, hsize_t buffer_size):
+  _type(type),
+  _width(width),
+  _max_size(buffer_size),
+  _offset(0)
+{
+  // only the first dimension can grow
+  hsize_t initial[2] = {0, width};
+  hsize_t eventual[2] = {H5S_UNLIMITED, width};
+  H5::DataSpace orig_space(2, initial, eventual);
+
+  // chunks hold complete rows, so reading a range of jets never
+  // touches more chunks than needed
+  H5::DSetCreatPropList params;
+  hsize_t chunk_size[2] = {buffer_size, width};
+  params.setChunk(2, chunk_size);
+  params.setDeflate(7);
+
+  _ds = group.createDataSet(ds_name, disk_type, orig_space, params);
+}
+
+template<typename T>
+void TwoDimBuffer<T>::push_back(const std::vector<T>& row) {
+  if (_buffer.size() == _max_size * _width) {
+    flush();
+  }
+  size_t n_copy = std::min<size_t>(row.size(), _width);
+  _buffer.insert(_buffer.end(), row.begin(), row.begin() + n_copy);
+  _buffer.resize(_buffer.size() + _width - n_copy, T());
+}
+
+// Same as OneDimBuffer::flush(), with a second (fixed) dimension
+template<typename T>
+void TwoDimBuffer<T>::flush() {
+  if (_buffer.size() == 0) return;
+
+  hsize_t n_rows = _buffer.size() / _width;
+  hsize_t slab_dims[2] = {n_rows, _width};
+  hsize_t total_dims[2] = {n_rows + _offset, _width};
+  _ds.extend(total_dims);
+
+  H5::DataSpace file_space = _ds.getSpace();
+  H5::DataSpace mem_space(2, slab_dims);
+  hsize_t offset_dims[2] = {_offset, 0};
+  file_space.selectHyperslab(H5S_SELECT_SET, slab_dims, offset_dims);
+
+  _ds.write(_buffer.data(), _type, mem_space, file_space);
+  _offset += n_rows;
+  _buffer.clear();
+}
+template<typename T>
+hsize_t TwoDimBuffer<T>::size() const
+{
+  return _offset + _buffer.size() / _width;
+}
+
+template<typename T>
+void TwoDimBuffer<T>::close() {
+  _ds.close();
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "h5merge.hh"
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+  // create an empty dataset with the same layout as `like`, which can
+  // be extended along the first dimension
+  H5::DataSet empty_copy(H5::CommonFG& group, const std::string& name,
+			 H5::DataSet& like) {
+    H5::DataSpace space = like.getSpace();
+    int rank = space.getSimpleExtentNdims();
+    std::vector<hsize_t> dims(rank);
+    space.getSimpleExtentDims(dims.data());
+    std::vector<hsize_t> max_dims(dims);
+    dims.at(0) = 0;
+    max_dims.at(0) = H5S_UNLIMITED;
+    H5::DataSpace orig_space(rank, dims.data(), max_dims.data());
+    return group.createDataSet(name, like.getDataType(), orig_space,
+			       like.getCreatePlist());
+  }
+
+  void merge_group(H5::CommonFG& from, H5::CommonFG& into,
+		   bool create, hsize_t block_size) {
+    hsize_t n_obj = from.getNumObjs();
+    for (hsize_t iii = 0; iii < n_obj; iii++) {
+      std::string name = from.getObjnameByIdx(iii);
+      switch (from.getObjTypeByIdx(iii)) {
+      case H5G_GROUP: {
+	H5::Group from_group = from.openGroup(name);
+	H5::Group into_group = create ?
+	  into.createGroup(name) : into.openGroup(name);
+	merge_group(from_group, into_group, create, block_size);
+	break;
+      }
+      case H5G_DATASET: {
+	H5::DataSet from_ds = from.openDataSet(name);
+	H5::DataSet into_ds = create ?
+	  empty_copy(into, name, from_ds) : into.openDataSet(name);
+	h5::append(from_ds, into_ds, block_size);
+	break;
+      }
+      default:
+	break;
+      }
+    }
+  }
+}
+
+namespace h5 {
+  void merge(const std::vector<std::string>& inputs,
+	     const std::string& output, hsize_t block_size) {
+    H5::H5File out_file(output, H5F_ACC_TRUNC);
+    bool first = true;
+    for (const auto& input: inputs) {
+      H5::H5File in_file(input, H5F_ACC_RDONLY);
+      merge_group(in_file, out_file, first, block_size);
+      first = false;
+    }
+  }
+
+  void append(H5::DataSet& from, H5::DataSet& into, hsize_t block_size) {
+    H5::DataType type = from.getDataType();
+    H5::DataSpace from_space = from.getSpace();
+    int rank = from_space.getSimpleExtentNdims();
+    if (rank < 1 || into.getSpace().getSimpleExtentNdims() != rank) {
+      throw std::runtime_error("can't append datasets of different rank");
+    }
+    std::vector<hsize_t> from_dims(rank);
+    from_space.getSimpleExtentDims(from_dims.data());
+    std::vector<hsize_t> into_dims(rank);
+    into.getSpace().getSimpleExtentDims(into_dims.data());
+
+    // size of one entry along the first dimension
+    size_t entry_size = type.getSize();
+    for (int dim = 1; dim < rank; dim++) entry_size *= from_dims.at(dim);
+    std::vector<char> buffer(entry_size * block_size);
+
+    const hsize_t n_entries = from_dims.at(0);
+    for (hsize_t start = 0; start < n_entries; start += block_size) {
+      std::vector<hsize_t> slab_dims(from_dims);
+      slab_dims.at(0) = std::min(block_size, n_entries - start);
+      std::vector<hsize_t> from_offset(rank, 0);
+      from_offset.at(0) = start;
+      std::vector<hsize_t> into_offset(rank, 0);
+      into_offset.at(0) = into_dims.at(0);
+
+      H5::DataSpace mem_space(rank, slab_dims.data());
+      H5::DataSpace read_space = from.getSpace();
+      read_space.selectHyperslab(H5S_SELECT_SET, slab_dims.data(),
+				 from_offset.data());
+      from.read(buffer.data(), type, mem_space, read_space);
+
+      into_dims.at(0) += slab_dims.at(0);
+      into.extend(into_dims.data());
+      H5::DataSpace write_space = into.getSpace();
+      write_space.selectHyperslab(H5S_SELECT_SET, slab_dims.data(),
+				  into_offset.data());
+      into.write(buffer.data(), type, mem_space, write_space);
+
+      // variable length entries are allocated by HDF5 when reading
+      H5::DataSet::vlenReclaim(buffer.data(), type, mem_space);
+    }
+  }
+}
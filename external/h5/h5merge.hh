@@ -0,0 +1,28 @@
+// Merge several HDF5 files into one.
+//
+// Every dataset found in the input files (including the ones within
+// groups) is appended along its first dimension, in the order the
+// files are given. All inputs must have the same layout, as is the
+// case for files written by several jobs with the same configuration.
+
+#ifndef H5_MERGE_HH
+#define H5_MERGE_HH
+
+#include "H5Cpp.h"
+#include <string>
+#include <vector>
+
+namespace h5 {
+  // Merge `inputs` into a new file `output`. Datasets are copied in
+  // blocks of `block_size` entries, so the memory use doesn't depend on
+  // the size of the inputs.
+  void merge(const std::vector<std::string>& inputs,
+	     const std::string& output, hsize_t block_size = 1000);
+
+  // Append all entries of `from` to the dataset `into`, which must have
+  // the same type and be extendible along its first dimension.
+  void append(H5::DataSet& from, H5::DataSet& into,
+	      hsize_t block_size = 1000);
+}
+
+#endif
@@ -4,4 +4,7 @@ namespace h5 {
   H5::DataType type(int) { return H5::PredType::NATIVE_INT; }
   H5::DataType type(double) {return H5::PredType::NATIVE_DOUBLE; }
   H5::DataType type(float) {return H5::PredType::NATIVE_FLOAT; }
+  H5::DataType type(unsigned char) {
+    return H5::PredType::NATIVE_UCHAR;
+  }
 }
@@ -379,7 +379,7 @@ void Calorimeter::Process()
       {
         if(fElectronsFromTrack)
         {
-          fTower->ECalEnergyTimePairs.push_back(make_pair<Float_t, Float_t>(ecalEnergy, track->Position.T()));
+          fTower->Calorimeter().ECalEnergyTimePairs.push_back(make_pair<Float_t, Float_t>(ecalEnergy, track->Position.T()));
         }
       }
 
@@ -406,7 +406,7 @@ void Calorimeter::Process()
     {
       if (abs(particle->PID) != 11 || !fElectronsFromTrack)
       {
-        fTower->ECalEnergyTimePairs.push_back(make_pair<Float_t, Float_t>(ecalEnergy, particle->Position.T()));
+        fTower->Calorimeter().ECalEnergyTimePairs.push_back(make_pair<Float_t, Float_t>(ecalEnergy, particle->Position.T()));
       }
     }
 
@@ -461,10 +461,11 @@ void Calorimeter::FinalizeTower()
   sumWeightedTime = 0.0;
   sumWeight = 0.0;
 
-  for(size_t i = 0; i < fTower->ECalEnergyTimePairs.size(); ++i)
+  const std::vector< std::pair< Float_t, Float_t > > &timePairs = fTower->GetCalorimeter().ECalEnergyTimePairs;
+  for(size_t i = 0; i < timePairs.size(); ++i)
   {
-    weight = TMath::Sqrt(fTower->ECalEnergyTimePairs[i].first);
-    sumWeightedTime += weight * fTower->ECalEnergyTimePairs[i].second;
+    weight = TMath::Sqrt(timePairs[i].first);
+    sumWeightedTime += weight * timePairs[i].second;
     sumWeight += weight;
     fTower->NTimeHits++;
   }
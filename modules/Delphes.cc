@@ -52,12 +52,56 @@
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
+#include <set>
 
 #include <string.h>
 #include <stdio.h>
 
 using namespace std;
 
+namespace {
+  // find references to the arrays exported by one of the modules,
+  // i.e. "Module/array" tokens, in a parameter value
+  Bool_t References(const TString &value, const set<TString> &modules)
+  {
+    set<TString>::const_iterator itModules;
+    Ssiz_t position;
+    for(itModules = modules.begin(); itModules != modules.end(); ++itModules)
+    {
+      const TString token = *itModules + "/";
+      position = value.Index(token);
+      while(position != kNPOS)
+      {
+        if(position == 0 || strchr(" \t\n{\"", value[position - 1])) return kTRUE;
+        position = value.Index(token, position + 1);
+      }
+    }
+    return kFALSE;
+  }
+
+  // redirect "Module/array" references to "Module<suffix>/array"
+  TString Redirect(TString value, const set<TString> &modules, const TString &suffix)
+  {
+    set<TString>::const_iterator itModules;
+    Ssiz_t position;
+    for(itModules = modules.begin(); itModules != modules.end(); ++itModules)
+    {
+      const TString token = *itModules + "/";
+      position = value.Index(token);
+      while(position != kNPOS)
+      {
+        if(position == 0 || strchr(" \t\n{\"", value[position - 1]))
+        {
+          value.Insert(position + itModules->Length(), suffix);
+          position += suffix.Length();
+        }
+        position = value.Index(token, position + 1);
+      }
+    }
+    return value;
+  }
+}
+
 Delphes::Delphes(const char *name) :
   fFactory(0)
 {
@@ -117,12 +161,20 @@ void Delphes::Init()
 
   ExRootConfParam param = confReader->GetParam("::ExecutionPath");
   Long_t i, size = param.GetSize();
+  vector<TString> path;
 
   gRandom->SetSeed(confReader->GetInt("::RandomSeed", 0));
 
   for(i = 0; i < size; ++i)
   {
-    name = param[i].GetString();
+    path.push_back(param[i].GetString());
+  }
+
+  ExpandScan(path);
+
+  for(i = 0; i < Long_t(path.size()); ++i)
+  {
+    name = path[i];
     itModules = modules->find(name);
     if(itModules != modules->end())
     {
@@ -144,6 +196,111 @@ void Delphes::Init()
 
 //------------------------------------------------------------------------------
 
+void Delphes::ExpandScan(vector<TString> &path)
+{
+  // Parameter scan: "add ScanParameters Module Parameter {values}" declares
+  // a list of values for a module parameter. For every value, the scanned
+  // modules and all the modules depending on their output arrays are
+  // duplicated as "Module<ScanSuffix><index>", while the upstream modules
+  // and their arrays are shared by all the variations.
+
+  stringstream message;
+  ExRootConfReader *confReader = GetConfReader();
+  const ExRootConfReader::ExRootTaskMap *modules = confReader->GetModules();
+  ExRootConfReader::ExRootTaskMap::const_iterator itModules;
+
+  ExRootConfParam param = confReader->GetParam("::ScanParameters");
+  Long_t i, j, k, size = param.GetSize();
+  Long_t variations = 0;
+
+  if(size == 0) return;
+
+  if(size % 3 != 0)
+  {
+    message << "::ScanParameters should be a list of {module parameter {values}}";
+    throw runtime_error(message.str());
+  }
+
+  TString suffix = confReader->GetString("::ScanSuffix", "_scan");
+  TString name, value;
+  vector<TString> expanded, params;
+  set<TString> affected;
+
+  for(i = 0; i < size/3; ++i)
+  {
+    name = param[i*3].GetString();
+    if(find(path.begin(), path.end(), name) == path.end())
+    {
+      message << "module '" << name;
+      message << "' is specified in ScanParameters but not in ExecutionPath.";
+      throw runtime_error(message.str());
+    }
+    if(i == 0) variations = param[i*3 + 2].GetSize();
+    if(param[i*3 + 2].GetSize() != variations)
+    {
+      message << "all ScanParameters should have the same number of values.";
+      throw runtime_error(message.str());
+    }
+    affected.insert(name);
+  }
+
+  // modules reading arrays from an affected module are affected as well
+  for(i = 0; i < Long_t(path.size()); ++i)
+  {
+    if(affected.count(path[i])) continue;
+    params = confReader->GetModuleParams(path[i]);
+    for(j = 0; j < Long_t(params.size()); ++j)
+    {
+      value = confReader->GetString(path[i] + "::" + params[j], "");
+      if(References(value, affected))
+      {
+        affected.insert(path[i]);
+        break;
+      }
+    }
+  }
+
+  // each copy runs right after its original module, so that all its
+  // inputs (shared or varied) are already available
+  for(i = 0; i < Long_t(path.size()); ++i)
+  {
+    expanded.push_back(path[i]);
+    if(!affected.count(path[i])) continue;
+
+    itModules = modules->find(path[i]);
+    if(itModules == modules->end()) continue;
+
+    params = confReader->GetModuleParams(path[i]);
+    for(k = 0; k < variations; ++k)
+    {
+      const TString tag = suffix + TString::Format("%ld", k);
+      name = path[i] + tag;
+      confReader->AddModule(itModules->second, name);
+      for(j = 0; j < Long_t(params.size()); ++j)
+      {
+        value = confReader->GetString(path[i] + "::" + params[j], "");
+        confReader->SetParam(name + "::" + params[j], Redirect(value, affected, tag));
+      }
+      confReader->SetParam(name + "::ScanSuffix", tag);
+      expanded.push_back(name);
+    }
+  }
+
+  for(i = 0; i < size/3; ++i)
+  {
+    name = param[i*3].GetString();
+    for(k = 0; k < variations; ++k)
+    {
+      const TString tag = suffix + TString::Format("%ld", k);
+      confReader->SetParam(name + tag + "::" + param[i*3 + 1].GetString(), param[i*3 + 2][k].GetString());
+    }
+  }
+
+  path.swap(expanded);
+}
+
+//------------------------------------------------------------------------------
+
 void Delphes::Process()
 {
 }
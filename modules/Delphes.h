@@ -30,6 +30,8 @@
 
 #include "classes/DelphesModule.h"
 
+#include <vector>
+
 class TFolder;
 class TObjArray;
 
@@ -56,6 +58,8 @@ public:
 
 private:
 
+  void ExpandScan(std::vector<TString> &path);
+
   DelphesFactory *fFactory;
 
   ClassDef(Delphes, 1)
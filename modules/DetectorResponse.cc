@@ -0,0 +1,205 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/** \class DetectorResponse
+ *
+ *  Applies an efficiency and the momentum, energy, angular and time
+ *  resolutions in a single pass, in the same order as a chain of
+ *  Efficiency, MomentumSmearing, EnergySmearing, AngularSmearing and
+ *  TimeSmearing modules. Only the resolutions given in the card are
+ *  applied, and each surviving candidate is cloned once.
+ *
+ */
+
+#include "modules/DetectorResponse.h"
+
+#include "classes/DelphesClasses.h"
+#include "classes/DelphesFactory.h"
+#include "classes/DelphesArrayView.h"
+#include "classes/DelphesFormula.h"
+
+#include "ExRootAnalysis/ExRootResult.h"
+#include "ExRootAnalysis/ExRootFilter.h"
+#include "ExRootAnalysis/ExRootClassifier.h"
+
+#include "TMath.h"
+#include "TString.h"
+#include "TFormula.h"
+#include "TRandom3.h"
+#include "TObjArray.h"
+#include "TDatabasePDG.h"
+#include "TLorentzVector.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+//------------------------------------------------------------------------------
+
+DetectorResponse::DetectorResponse() :
+  fEfficiencyFormula(0), fMomentumFormula(0), fEnergyFormula(0),
+  fEtaFormula(0), fPhiFormula(0), fTimeResolution(0.0)
+{
+}
+
+//------------------------------------------------------------------------------
+
+DetectorResponse::~DetectorResponse()
+{
+  if(fEfficiencyFormula) delete fEfficiencyFormula;
+  if(fMomentumFormula) delete fMomentumFormula;
+  if(fEnergyFormula) delete fEnergyFormula;
+  if(fEtaFormula) delete fEtaFormula;
+  if(fPhiFormula) delete fPhiFormula;
+}
+
+//------------------------------------------------------------------------------
+
+DelphesFormula *DetectorResponse::CompileFormula(const char *name)
+{
+  DelphesFormula *formula;
+  const char *expression = GetString(name, "");
+
+  if(expression[0] == '\0') return 0;
+
+  formula = new DelphesFormula;
+  formula->Compile(expression);
+  return formula;
+}
+
+//------------------------------------------------------------------------------
+
+void DetectorResponse::Init()
+{
+  // read efficiency and resolution formulas, a missing formula switches the step off
+
+  fEfficiencyFormula = CompileFormula("EfficiencyFormula");
+  fMomentumFormula = CompileFormula("MomentumResolutionFormula");
+  fEnergyFormula = CompileFormula("EnergyResolutionFormula");
+  fEtaFormula = CompileFormula("EtaResolutionFormula");
+  fPhiFormula = CompileFormula("PhiResolutionFormula");
+
+  // time resolution in s
+
+  fTimeResolution = GetDouble("TimeResolution", 0.0);
+
+  // import input array
+
+  fInputArray = ImportArray(GetString("InputArray", "ParticlePropagator/stableParticles"));
+
+  // create output array
+
+  fOutputArray = ExportArray(GetString("OutputArray", "stableParticles"));
+}
+
+//------------------------------------------------------------------------------
+
+void DetectorResponse::Finish()
+{
+}
+
+//------------------------------------------------------------------------------
+
+void DetectorResponse::Process()
+{
+  Candidate *mother;
+  TLorentzVector momentum;
+  Double_t pt, eta, phi, e, t;
+  Double_t momentumEta, momentumPhi;
+  Bool_t smear;
+  const Double_t c_light = 2.99792458E8;
+
+  smear = fMomentumFormula || fEnergyFormula || fEtaFormula || fPhiFormula || fTimeResolution > 0.0;
+
+  for(Candidate *candidate : CandidateArrayView(fInputArray))
+  {
+    const TLorentzVector &candidatePosition = candidate->Position;
+    eta = candidatePosition.Eta();
+    phi = candidatePosition.Phi();
+
+    momentum = candidate->Momentum;
+    pt = momentum.Pt();
+    e = momentum.E();
+
+    // apply an efficency formula
+    if(fEfficiencyFormula && gRandom->Uniform() > fEfficiencyFormula->Eval(pt, eta, phi, e)) continue;
+
+    if(!smear)
+    {
+      fOutputArray->Add(candidate);
+      continue;
+    }
+
+    momentumEta = momentum.Eta();
+    momentumPhi = momentum.Phi();
+
+    // transverse momentum resolution, relative to pt
+    if(fMomentumFormula)
+    {
+      pt = gRandom->Gaus(pt, fMomentumFormula->Eval(pt, eta, phi, e) * pt);
+      if(pt <= 0.0) continue;
+
+      e = pt*TMath::CosH(momentumEta);
+    }
+
+    // energy resolution, the formula takes the transverse position as pt
+    if(fEnergyFormula)
+    {
+      e = gRandom->Gaus(e, fEnergyFormula->Eval(candidatePosition.Pt(), eta, phi, e));
+      if(e <= 0.0) continue;
+
+      pt = e/TMath::CosH(momentumEta);
+    }
+
+    // angular resolution, applied to the momentum direction
+    if(fEtaFormula || fPhiFormula)
+    {
+      if(fEtaFormula) momentumEta = gRandom->Gaus(momentumEta, fEtaFormula->Eval(pt, eta, phi, e));
+      if(fPhiFormula) momentumPhi = gRandom->Gaus(momentumPhi, fPhiFormula->Eval(pt, eta, phi, e));
+
+      e = pt*TMath::CosH(momentumEta);
+    }
+
+    if(fMomentumFormula || fEnergyFormula || fEtaFormula || fPhiFormula)
+    {
+      momentum.SetPtEtaPhiE(pt, momentumEta, momentumPhi, e);
+    }
+
+    mother = candidate;
+    candidate = static_cast<Candidate*>(candidate->Clone());
+    candidate->Momentum = momentum;
+
+    // time resolution
+    if(fTimeResolution > 0.0)
+    {
+      t = candidatePosition.T()*1.0E-3/c_light;
+      t = gRandom->Gaus(t, fTimeResolution);
+      candidate->Position.SetT(t*1.0E3*c_light);
+    }
+
+    candidate->AddCandidate(mother);
+
+    fOutputArray->Add(candidate);
+  }
+}
+
+//------------------------------------------------------------------------------
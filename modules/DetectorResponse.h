@@ -0,0 +1,67 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DetectorResponse_h
+#define DetectorResponse_h
+
+/** \class DetectorResponse
+ *
+ *  Applies an efficiency and the momentum, energy, angular and time
+ *  resolutions in a single pass, in the same order as a chain of
+ *  Efficiency, MomentumSmearing, EnergySmearing, AngularSmearing and
+ *  TimeSmearing modules. Only the resolutions given in the card are
+ *  applied, and each surviving candidate is cloned once.
+ *
+ */
+
+#include "classes/DelphesModule.h"
+
+class TObjArray;
+class DelphesFormula;
+
+class DetectorResponse: public DelphesModule
+{
+public:
+
+  DetectorResponse();
+  ~DetectorResponse();
+
+  void Init();
+  void Process();
+  void Finish();
+
+private:
+
+  DelphesFormula *CompileFormula(const char *name);
+
+  DelphesFormula *fEfficiencyFormula; //!
+  DelphesFormula *fMomentumFormula; //!
+  DelphesFormula *fEnergyFormula; //!
+  DelphesFormula *fEtaFormula; //!
+  DelphesFormula *fPhiFormula; //!
+
+  Double_t fTimeResolution;
+
+  const TObjArray *fInputArray; //!
+
+  TObjArray *fOutputArray; //!
+
+  ClassDef(DetectorResponse, 1)
+};
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesArrayView.h"
 #include "classes/DelphesFormula.h"
 
 #include "ExRootAnalysis/ExRootResult.h"
@@ -53,7 +54,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 
 EnergyScale::EnergyScale() :
-  fFormula(0), fItInputArray(0)
+  fFormula(0)
 {
   fFormula = new DelphesFormula;
 }
@@ -76,7 +77,6 @@ void EnergyScale::Init()
   // import input array
 
   fInputArray = ImportArray(GetString("InputArray", "FastJetFinder/jets"));
-  fItInputArray = fInputArray->MakeIterator();
 
   // create output array
 
@@ -87,19 +87,16 @@ void EnergyScale::Init()
 
 void EnergyScale::Finish()
 {
-  if(fItInputArray) delete fItInputArray;
 }
 
 //------------------------------------------------------------------------------
 
 void EnergyScale::Process()
 {
-  Candidate *candidate;
   TLorentzVector momentum;
   Double_t scale;
   
-  fItInputArray->Reset();
-  while((candidate = static_cast<Candidate*>(fItInputArray->Next())))
+  for(Candidate *candidate : CandidateArrayView(fInputArray))
   {
     momentum = candidate->Momentum;
 
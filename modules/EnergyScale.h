@@ -29,7 +29,6 @@
 
 #include "classes/DelphesModule.h"
 
-class TIterator;
 class TObjArray;
 class DelphesFormula;
 
@@ -48,8 +47,6 @@ private:
 
   DelphesFormula *fFormula; //!
 
-  TIterator *fItInputArray; //!
-
   const TObjArray *fInputArray; //!
   
   TObjArray *fOutputArray; //!
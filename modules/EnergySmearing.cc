@@ -29,6 +29,7 @@
 
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesArrayView.h"
 #include "classes/DelphesFormula.h"
 
 #include "ExRootAnalysis/ExRootResult.h"
@@ -53,7 +54,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 
 EnergySmearing::EnergySmearing() :
-  fFormula(0), fItInputArray(0)
+  fFormula(0)
 {
   fFormula = new DelphesFormula;
 }
@@ -76,7 +77,6 @@ void EnergySmearing::Init()
   // import input array
 
   fInputArray = ImportArray(GetString("InputArray", "ParticlePropagator/stableParticles"));
-  fItInputArray = fInputArray->MakeIterator();
 
   // create output array
 
@@ -87,18 +87,16 @@ void EnergySmearing::Init()
 
 void EnergySmearing::Finish()
 {  
-  if(fItInputArray) delete fItInputArray;
 }
 
 //------------------------------------------------------------------------------
 
 void EnergySmearing::Process()
 {
-  Candidate *candidate, *mother;
+  Candidate *mother;
   Double_t pt, energy, eta, phi;
 
-  fItInputArray->Reset();
-  while((candidate = static_cast<Candidate*>(fItInputArray->Next())))
+  for(Candidate *candidate : CandidateArrayView(fInputArray))
   {
     const TLorentzVector &candidatePosition = candidate->Position;
     const TLorentzVector &candidateMomentum = candidate->Momentum;
@@ -429,18 +429,18 @@ void FastJetFinder::Process()
       
       trimmed_jet = join(trimmed_jet.constituents());
      
-      candidate->TrimmedP4[0].SetPtEtaPhiM(trimmed_jet.pt(), trimmed_jet.eta(), trimmed_jet.phi(), trimmed_jet.m());
+      candidate->Substructure().TrimmedP4[0].SetPtEtaPhiM(trimmed_jet.pt(), trimmed_jet.eta(), trimmed_jet.phi(), trimmed_jet.m());
         
       // four hardest subjets 
       subjets.clear();
       subjets = trimmed_jet.pieces();
       subjets = sorted_by_pt(subjets);
       
-      candidate->NSubJetsTrimmed = subjets.size();
+      candidate->Substructure().NSubJetsTrimmed = subjets.size();
 
       for (size_t i = 0; i < subjets.size() and i < 4; i++){
 	if(subjets.at(i).pt() < 0) continue ; 
- 	candidate->TrimmedP4[i+1].SetPtEtaPhiM(subjets.at(i).pt(), subjets.at(i).eta(), subjets.at(i).phi(), subjets.at(i).m());
+ 	candidate->Substructure().TrimmedP4[i+1].SetPtEtaPhiM(subjets.at(i).pt(), subjets.at(i).eta(), subjets.at(i).phi(), subjets.at(i).m());
       }
     }
     
@@ -456,18 +456,18 @@ void FastJetFinder::Process()
       fastjet::Pruner    pruner(fastjet::JetDefinition(fastjet::cambridge_algorithm,fRPrun),fZcutPrun,fRcutPrun);
       fastjet::PseudoJet pruned_jet = pruner(*itOutputList);
 
-      candidate->PrunedP4[0].SetPtEtaPhiM(pruned_jet.pt(), pruned_jet.eta(), pruned_jet.phi(), pruned_jet.m());
+      candidate->Substructure().PrunedP4[0].SetPtEtaPhiM(pruned_jet.pt(), pruned_jet.eta(), pruned_jet.phi(), pruned_jet.m());
          
       // four hardest subjet 
       subjets.clear();
       subjets = pruned_jet.pieces();
       subjets = sorted_by_pt(subjets);
       
-      candidate->NSubJetsPruned = subjets.size();
+      candidate->Substructure().NSubJetsPruned = subjets.size();
 
       for (size_t i = 0; i < subjets.size() and i < 4; i++){
 	if(subjets.at(i).pt() < 0) continue ; 
-  	candidate->PrunedP4[i+1].SetPtEtaPhiM(subjets.at(i).pt(), subjets.at(i).eta(), subjets.at(i).phi(), subjets.at(i).m());
+  	candidate->Substructure().PrunedP4[i+1].SetPtEtaPhiM(subjets.at(i).pt(), subjets.at(i).eta(), subjets.at(i).phi(), subjets.at(i).m());
       }
 
     } 
@@ -482,18 +482,18 @@ void FastJetFinder::Process()
       contrib::SoftDrop  softDrop(fBetaSoftDrop,fSymmetryCutSoftDrop,fR0SoftDrop);
       fastjet::PseudoJet softdrop_jet = softDrop(*itOutputList);
       
-      candidate->SoftDroppedP4[0].SetPtEtaPhiM(softdrop_jet.pt(), softdrop_jet.eta(), softdrop_jet.phi(), softdrop_jet.m());
+      candidate->Substructure().SoftDroppedP4[0].SetPtEtaPhiM(softdrop_jet.pt(), softdrop_jet.eta(), softdrop_jet.phi(), softdrop_jet.m());
         
       // four hardest subjet 
       
       subjets.clear();
       subjets    = softdrop_jet.pieces();
       subjets    = sorted_by_pt(subjets);
-      candidate->NSubJetsSoftDropped = softdrop_jet.pieces().size();
+      candidate->Substructure().NSubJetsSoftDropped = softdrop_jet.pieces().size();
 
       for (size_t i = 0; i < subjets.size()  and i < 4; i++){
 	if(subjets.at(i).pt() < 0) continue ; 
-  	candidate->SoftDroppedP4[i+1].SetPtEtaPhiM(subjets.at(i).pt(), subjets.at(i).eta(), subjets.at(i).phi(), subjets.at(i).m());
+  	candidate->Substructure().SoftDroppedP4[i+1].SetPtEtaPhiM(subjets.at(i).pt(), subjets.at(i).eta(), subjets.at(i).phi(), subjets.at(i).m());
       }
     }
   
@@ -528,11 +528,11 @@ void FastJetFinder::Process()
       Nsubjettiness nSub4(4, axisMode, measureMode, fBeta);
       Nsubjettiness nSub5(5, axisMode, measureMode, fBeta);
 
-      candidate->Tau[0] = nSub1(*itOutputList);
-      candidate->Tau[1] = nSub2(*itOutputList);
-      candidate->Tau[2] = nSub3(*itOutputList);
-      candidate->Tau[3] = nSub4(*itOutputList);
-      candidate->Tau[4] = nSub5(*itOutputList);
+      candidate->Substructure().Tau[0] = nSub1(*itOutputList);
+      candidate->Substructure().Tau[1] = nSub2(*itOutputList);
+      candidate->Substructure().Tau[2] = nSub3(*itOutputList);
+      candidate->Substructure().Tau[3] = nSub4(*itOutputList);
+      candidate->Substructure().Tau[4] = nSub5(*itOutputList);
     }
 
     fOutputArray->Add(candidate);
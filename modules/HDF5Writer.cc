@@ -40,6 +40,7 @@
 #include <iostream>
 #include <string>
 #include <limits>
+#include <algorithm>
 
 namespace {
   // double inf = std::numeric_limits<double>::infinity();
@@ -61,7 +62,10 @@ namespace {
 
 HDF5Writer::HDF5Writer() :
   fItInputArray(0), m_out_file(0), m_hl_jet_buffer(0),
-  m_ml_jet_buffer(0), m_superjet_buffer(0)
+  m_ml_jet_buffer(0), m_superjet_buffer(0), m_flat_jet_buffer(0),
+  m_primary_track_buffer(0), m_secondary_track_buffer(0),
+  m_padded_primary_buffer(0), m_padded_secondary_buffer(0),
+  m_padded_primary_mask(0), m_padded_secondary_mask(0)
 {
 }
 
@@ -73,6 +77,13 @@ HDF5Writer::~HDF5Writer()
   delete m_hl_jet_buffer;
   delete m_ml_jet_buffer;
   delete m_superjet_buffer;
+  delete m_flat_jet_buffer;
+  delete m_primary_track_buffer;
+  delete m_secondary_track_buffer;
+  delete m_padded_primary_buffer;
+  delete m_padded_secondary_buffer;
+  delete m_padded_primary_mask;
+  delete m_padded_secondary_mask;
   delete fItInputArray;
 }
 
@@ -95,8 +106,9 @@ void HDF5Writer::Init()
   // get the name of the root output file
   auto* treeWriter = static_cast<ExRootTreeWriter*>(
     GetFolder()->FindObject("TreeWriter"));
+  // copies made by a parameter scan write to their own file
   const std::string output_file = remove_extension(
-    treeWriter->GetOutputFileName());
+    treeWriter->GetOutputFileName()) + GetString("ScanSuffix", "");
 
   // create the hdf5 output file
   std::string output_ext = GetString("OutputExtension", ".ntuple.h5");
@@ -111,8 +123,39 @@ void HDF5Writer::Init()
   //   *m_out_file, "high_level_jets", hl_jtype, 1000);
   // m_ml_jet_buffer = new OneDimBuffer<out::MediumLevelJet>(
   //   *m_out_file, "medium_level_jets", ml_jtype, 1000);
-  m_superjet_buffer = new OneDimBuffer<out::VLSuperJet>(
-    *m_out_file, "jets", superjet_type, 1000);
+  if (GetBool("FlatTracks", false)) {
+    // variable-length members are slow to read and compress badly,
+    // write the tracks to their own tables instead
+    m_flat_jet_buffer = new OneDimBuffer<out::FlatJet>(
+      *m_out_file, "jets", out::type(out::FlatJet()), 1000);
+    m_primary_track_buffer = new OneDimBuffer<out::VertexTrack>(
+      *m_out_file, "primary_vertex_tracks",
+      out::type(out::VertexTrack()), 10000);
+    m_secondary_track_buffer = new OneDimBuffer<out::CombinedSecondaryTrack>(
+      *m_out_file, "secondary_vertex_tracks",
+      out::type(out::CombinedSecondaryTrack()), 10000);
+  } else {
+    m_superjet_buffer = new OneDimBuffer<out::VLSuperJet>(
+      *m_out_file, "jets", superjet_type, 1000);
+  }
+
+  // fixed-size (jets x tracks) arrays, zero padded, with a mask to
+  // flag the real tracks. These line up with the jets dataset.
+  int max_padded_tracks = GetInt("MaxPaddedTracks", 0);
+  if (max_padded_tracks > 0) {
+    m_padded_primary_buffer = new TwoDimBuffer<out::VertexTrack>(
+      *m_out_file, "padded_primary_vertex_tracks",
+      out::type(out::VertexTrack()), max_padded_tracks, 1000);
+    m_padded_primary_mask = new TwoDimBuffer<unsigned char>(
+      *m_out_file, "padded_primary_vertex_tracks_mask",
+      h5::type((unsigned char)0), max_padded_tracks, 1000);
+    m_padded_secondary_buffer = new TwoDimBuffer<out::CombinedSecondaryTrack>(
+      *m_out_file, "padded_secondary_vertex_tracks",
+      out::type(out::CombinedSecondaryTrack()), max_padded_tracks, 1000);
+    m_padded_secondary_mask = new TwoDimBuffer<unsigned char>(
+      *m_out_file, "padded_secondary_vertex_tracks_mask",
+      h5::type((unsigned char)0), max_padded_tracks, 1000);
+  }
 
   // create the output text file
   std::string text_file_ext = GetString("TextFileExtension", "");
@@ -161,8 +204,8 @@ namespace out {
 
   HighLevelJet::HighLevelJet(Candidate& jet):
     jet_parameters(jet),
-    tracking(jet.hlTrk),
-    vertex(jet.hlSvx)
+    tracking(jet.GetVertexing().hlTrk),
+    vertex(jet.GetVertexing().hlSvx)
   {
   }
 
@@ -201,20 +244,21 @@ namespace out {
   MediumLevelJet::MediumLevelJet(Candidate& jet):
     jet_parameters(jet)
   {
-    for (const auto& trk: jet.primaryVertexTracks) {
+    for (const auto& trk: jet.GetVertexing().primaryVertexTracks) {
       primary_vertex_tracks.push_back(trk);
     }
-    for (const auto& vx: jet.secondaryVertices) {
+    for (const auto& vx: jet.GetVertexing().secondaryVertices) {
       secondary_vertices.push_back(SecondaryVertexWithTracks(vx));
     }
   }
   SuperJet::SuperJet(Candidate& jet):
-    jet_parameters(jet), tracking(jet.hlTrk), vertex(jet.hlSvx)
+    jet_parameters(jet), tracking(jet.GetVertexing().hlTrk),
+    vertex(jet.GetVertexing().hlSvx)
   {
-    for (const auto& trk: jet.primaryVertexTracks) {
+    for (const auto& trk: jet.GetVertexing().primaryVertexTracks) {
       primary_vertex_tracks.push_back(trk);
     }
-    for (const auto& vx: jet.secondaryVertices) {
+    for (const auto& vx: jet.GetVertexing().secondaryVertices) {
       secondary_vertices.push_back(SecondaryVertexWithTracks(vx));
     }
   }
@@ -241,8 +285,8 @@ namespace out {
 
   VLSuperJet::VLSuperJet(Candidate& jet):
     jet_parameters(jet),
-    tracking(jet.hlTrk),
-    vertex(jet.hlSvx)
+    tracking(jet.GetVertexing().hlTrk),
+    vertex(jet.GetVertexing().hlSvx)
   {
     // sort primary tracks
     primary_vertex_tracks = get_sorted_primary_tracks(jet);
@@ -251,13 +295,22 @@ namespace out {
     secondary_vertex_tracks = get_sorted_secondary_tracks(jet);
   }
 
+  FlatJet::FlatJet(Candidate& jet, int n_primary, int n_secondary):
+    jet_parameters(jet),
+    tracking(jet.GetVertexing().hlTrk),
+    vertex(jet.GetVertexing().hlSvx),
+    n_primary_vertex_tracks(n_primary),
+    n_secondary_vertex_tracks(n_secondary)
+  {
+  }
+
   JetTracks::JetTracks(Candidate& jet):
     jet_parameters(jet),
-    tracking(jet.hlTrk),
-    vertex(jet.hlSvx)
+    tracking(jet.GetVertexing().hlTrk),
+    vertex(jet.GetVertexing().hlSvx)
   {
     for (const auto& track: get_sorted_primary_tracks(jet)) {
-      auto combined = CombinedSecondaryTrack(track, jet.primaryVertex);
+      auto combined = CombinedSecondaryTrack(track, jet.GetVertexing().primaryVertex);
       all_tracks.push_back(combined);
     }
     for (const auto& track: get_sorted_secondary_tracks(jet)) {
@@ -363,6 +416,15 @@ namespace out {
     H5_INSERT(out, VLSuperJet, secondary_vertex_tracks);
     return out;
   }
+  H5::CompType type(FlatJet) {
+    H5::CompType out(sizeof(FlatJet));
+    H5_INSERT(out, FlatJet, jet_parameters);
+    H5_INSERT(out, FlatJet, tracking);
+    H5_INSERT(out, FlatJet, vertex);
+    H5_INSERT(out, FlatJet, n_primary_vertex_tracks);
+    H5_INSERT(out, FlatJet, n_secondary_vertex_tracks);
+    return out;
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -381,6 +443,24 @@ void HDF5Writer::Finish()
     m_superjet_buffer->flush();
     m_superjet_buffer->close();
   }
+  if (m_flat_jet_buffer) {
+    m_flat_jet_buffer->flush();
+    m_flat_jet_buffer->close();
+    m_primary_track_buffer->flush();
+    m_primary_track_buffer->close();
+    m_secondary_track_buffer->flush();
+    m_secondary_track_buffer->close();
+  }
+  if (m_padded_primary_buffer) {
+    m_padded_primary_buffer->flush();
+    m_padded_primary_buffer->close();
+    m_padded_primary_mask->flush();
+    m_padded_primary_mask->close();
+    m_padded_secondary_buffer->flush();
+    m_padded_secondary_buffer->close();
+    m_padded_secondary_mask->flush();
+    m_padded_secondary_mask->close();
+  }
   if (m_output_stream.is_open()) {
     m_output_stream.close();
   }
@@ -401,6 +481,32 @@ void HDF5Writer::Process()
     if (m_hl_jet_buffer) m_hl_jet_buffer->push_back(*jet);
     if (m_ml_jet_buffer) m_ml_jet_buffer->push_back(*jet);
     if (m_superjet_buffer) m_superjet_buffer->push_back(*jet);
+    if (m_flat_jet_buffer) {
+      const auto primary = get_sorted_primary_tracks(*jet);
+      const auto secondary = get_sorted_secondary_tracks(*jet);
+      for (const auto& trk: primary) {
+        m_primary_track_buffer->push_back(trk);
+      }
+      for (const auto& trk: secondary) {
+        m_secondary_track_buffer->push_back(trk);
+      }
+      m_flat_jet_buffer->push_back(
+        out::FlatJet(*jet, primary.size(), secondary.size()));
+    }
+    if (m_padded_primary_buffer) {
+      // tracks beyond MaxPaddedTracks are dropped: the arrays start
+      // with the largest signed d0, so the displaced tracks are kept
+      auto primary = get_sorted_primary_tracks(*jet);
+      auto secondary = get_sorted_secondary_tracks(*jet);
+      std::reverse(primary.begin(), primary.end());
+      std::reverse(secondary.begin(), secondary.end());
+      m_padded_primary_buffer->push_back(primary);
+      m_padded_primary_mask->push_back(
+        std::vector<unsigned char>(primary.size(), 1));
+      m_padded_secondary_buffer->push_back(secondary);
+      m_padded_secondary_mask->push_back(
+        std::vector<unsigned char>(secondary.size(), 1));
+    }
   }
 }
 
@@ -533,6 +639,14 @@ namespace out {
     return out;
   }
 
+  std::ostream& operator<<(std::ostream& out, const FlatJet& pars) {
+    out << pars.jet_parameters;
+    out << ", {" << pars.tracking << "}, {" << pars.vertex << "}";
+    out << ", " << pars.n_primary_vertex_tracks;
+    out << ", " << pars.n_secondary_vertex_tracks;
+    return out;
+  }
+
   std::ostream& operator<<(std::ostream& out,
                            const JetTracks& pars) {
     out << pars.jet_parameters;
@@ -548,7 +662,7 @@ namespace {
   get_sorted_primary_tracks(Candidate& jet) {
     using namespace out;
     std::vector<VertexTrack> sorted_tracks;
-    for (const auto& trk: jet.primaryVertexTracks) {
+    for (const auto& trk: jet.GetVertexing().primaryVertexTracks) {
       sorted_tracks.push_back(trk);
     }
     std::sort(sorted_tracks.begin(), sorted_tracks.end());
@@ -566,8 +680,8 @@ namespace {
     std::map<Candidate*, double> used;
     int n_overlap = 0;
     std::vector<CombinedSecondaryTrack> sorted_secondary_tracks;
-    for (auto vx = jet.secondaryVertices.crbegin();
-    	 vx != jet.secondaryVertices.crend(); vx++) {
+    const auto& vertices = jet.GetVertexing().secondaryVertices;
+    for (auto vx = vertices.crbegin(); vx != vertices.crend(); vx++) {
       for (const auto& trk: vx->tracks_along_jet) {
         if (!used.count(trk.delphes_track)) {
           sorted_secondary_tracks.emplace_back(trk, *vx);
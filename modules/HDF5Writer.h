@@ -42,6 +42,7 @@ class HighLevelSvx;
 #ifndef __CINT__
 
 #include "external/h5/OneDimBuffer.hh"
+#include "external/h5/TwoDimBuffer.hh"
 #include "external/h5/h5container.hh"
 
 #include "classes/DelphesModule.h"
@@ -227,6 +228,24 @@ namespace out {
     h5::vector<CombinedSecondaryTrack> all_tracks;
   };
   std::ostream& operator<<(std::ostream&, const JetTracks&);
+
+  // ******************** flat track tables ********************
+  // Tracks are written to their own tables (`VertexTrack` and
+  // `CombinedSecondaryTrack` rows), the jet only stores how many
+  // tracks it owns. The offset of the first track of a jet is the sum
+  // of the counts of the previous jets, so files can be concatenated.
+  struct FlatJet {
+    FlatJet(Candidate& jet, int n_primary, int n_secondary);
+    FlatJet() = default;
+    JetParameters jet_parameters;
+    HighLevelTracking tracking;
+    HighLevelSecondaryVertex vertex;
+
+    int n_primary_vertex_tracks;
+    int n_secondary_vertex_tracks;
+  };
+  std::ostream& operator<<(std::ostream&, const FlatJet&);
+  H5::CompType type(FlatJet);
 }
 
 #else  // CINT include dummy
@@ -263,6 +282,13 @@ private:
   OneDimBuffer<out::HighLevelJet>* m_hl_jet_buffer;
   OneDimBuffer<out::MediumLevelJet>* m_ml_jet_buffer;
   OneDimBuffer<out::VLSuperJet>* m_superjet_buffer;
+  OneDimBuffer<out::FlatJet>* m_flat_jet_buffer;
+  OneDimBuffer<out::VertexTrack>* m_primary_track_buffer;
+  OneDimBuffer<out::CombinedSecondaryTrack>* m_secondary_track_buffer;
+  TwoDimBuffer<out::VertexTrack>* m_padded_primary_buffer;
+  TwoDimBuffer<out::CombinedSecondaryTrack>* m_padded_secondary_buffer;
+  TwoDimBuffer<unsigned char>* m_padded_primary_mask;
+  TwoDimBuffer<unsigned char>* m_padded_secondary_mask;
 #endif
   std::ofstream m_output_stream;
 
@@ -50,10 +50,14 @@
 
 #include "Hector/H_BeamLine.h"
 #include "Hector/H_RecRPObject.h"
-#include "Hector/H_BeamParticle.h"
+#include "Hector/H_OpticalElement.h"
+#include "Hector/H_Aperture.h"
+#include "Hector/H_Parameters.h"
 
 using namespace std;
 
+extern bool relative_energy;
+
 //------------------------------------------------------------------------------
 
 Hector::Hector() :
@@ -71,6 +75,8 @@ Hector::~Hector()
 
 void Hector::Init()
 {
+  Int_t i, j;
+
   // read Hector parameters
 
   fDirection = GetInt("Direction", 1);
@@ -89,6 +95,36 @@ void Hector::Init()
   fBeamLine->offsetElements(fOffsetS, fOffsetX);
   fBeamLine->calcMatrix();
 
+  // element offsets, apertures and matrices used by the transport in Process,
+  // only the matrices of the magnets depend on the energy loss of each particle
+  fElements.resize(fBeamLine->getNumberOfElements());
+  for(i = 0; i < fBeamLine->getNumberOfElements(); ++i)
+  {
+    const H_OpticalElement *element = fBeamLine->getElement(i);
+    TElement &cache = fElements[i];
+    Int_t type = element->getType();
+
+    cache.optics = element;
+    cache.x = element->getX();
+    cache.tx = tan(element->getTX()/URAD)*URAD;
+    cache.y = element->getY();
+    cache.ty = tan(element->getTY()/URAD)*URAD;
+    cache.s = element->getS() + element->getLength();
+    cache.aperture = element->getAperture()->getType() != NONE;
+
+    if(type == VKICKER || type == HKICKER ||
+      ((type == RDIPOLE || type == SDIPOLE || type == VQUADRUPOLE || type == HQUADRUPOLE) && element->getK() != 0.0))
+    {
+      cache.fixed = kFALSE;
+    }
+    else
+    {
+      cache.fixed = kTRUE;
+      const TMatrix matrix = element->getMatrix(0.0, MP, QP);
+      for(j = 0; j < 36; ++j) cache.matrix[j] = matrix.GetMatrixArray()[j];
+    }
+  }
+
   // import input array
 
   fInputArray = ImportArray(GetString("InputArray", "ParticlePropagator/stableParticles"));
@@ -112,12 +148,24 @@ void Hector::Finish()
 void Hector::Process()
 {
   Candidate *candidate, *mother;
-  Double_t pz;
-  Double_t x, y, z, tx, ty, theta;
+  vector< TElement >::const_iterator itElement;
+  vector< TBeamParticle >::iterator itParticle;
+  TBeamParticle particle;
+  const Double_t *m;
+  Double_t pz, energy;
+  Double_t x, y, z, tx, ty, theta, l;
   Double_t distance, time;
+  Double_t vec[6], elementMatrix[36];
+  Int_t i, j, alive;
 
   const Double_t c_light = 2.99792458E8;
 
+  // collect the forward particles and set their initial state
+  // in the same order as H_BeamParticle would, so that the same
+  // random numbers are used
+
+  fParticles.clear();
+
   fItInputArray->Reset();
   while((candidate = static_cast<Candidate*>(fItInputArray->Next())))
   {
@@ -141,25 +189,136 @@ void Hector::Process()
     distance = (fDistance - 1.0E-3 * candidatePosition.Z())/TMath::Cos(theta);
     time = gRandom->Gaus((distance + 1.0E-3 * candidatePosition.T())/c_light, fSigmaT);
 
-    H_BeamParticle particle(candidate->Mass, candidate->Charge);
-//    particle.set4Momentum(candidateMomentum);
-    particle.set4Momentum(candidateMomentum.Px(), candidateMomentum.Py(), 
-                          candidateMomentum.Pz(), candidateMomentum.E());
-    particle.setPosition(x, y, tx, ty, z);
-
-    particle.smearAng(fSigmaX, fSigmaY, gRandom);
-    particle.smearE(fSigmaE, gRandom);
-
-    particle.computePath(fBeamLine);
+    tx = gRandom->Gaus(tx, fSigmaX);
+    ty = gRandom->Gaus(ty, fSigmaY);
+    energy = gRandom->Gaus(candidateMomentum.E(), fSigmaE);
+
+    particle.candidate = candidate;
+    particle.time = time;
+    particle.energy = energy;
+    particle.mass = candidate->Mass;
+    particle.charge = (candidate->Mass == 0.0) ? 0.0 : candidate->Charge;
+    particle.energyLoss = BE - energy;
+
+    particle.vec[0] = x/URAD;
+    particle.vec[1] = tan(tx/URAD);
+    particle.vec[2] = y/URAD;
+    particle.vec[3] = tan(ty/URAD);
+    particle.vec[4] = relative_energy ? energy - BE : energy;
+    particle.vec[5] = 1.0;
+
+    particle.x = x;
+    particle.tx = tx;
+    particle.y = y;
+    particle.ty = ty;
+    particle.s = z;
+
+    // as in H_BeamParticle::propagate, a particle that starts at or after
+    // the requested distance keeps its starting s and its position at the
+    // end of the beam line
+    particle.hitS = z;
+    particle.found = kFALSE;
+    particle.searching = (fDistance > z);
+    particle.stopped = kFALSE;
+
+    fParticles.push_back(particle);
+  }
 
-    if(particle.stopped(fBeamLine)) continue;
+  // transport all particles through one element after the other,
+  // a particle stopped by an aperture is not transported any further
 
-    particle.propagate(fDistance);
+  alive = fParticles.size();
+  for(itElement = fElements.begin(); itElement != fElements.end() && alive > 0; ++itElement)
+  {
+    const TElement &element = *itElement;
+
+    for(itParticle = fParticles.begin(); itParticle != fParticles.end(); ++itParticle)
+    {
+      TBeamParticle &p = *itParticle;
+      if(p.stopped) continue;
+
+      p.vec[0] -= element.x;
+      p.vec[1] -= element.tx;
+      p.vec[2] -= element.y;
+      p.vec[3] -= element.ty;
+
+      if(element.fixed)
+      {
+        m = element.matrix;
+      }
+      else
+      {
+        const TMatrix matrix = element.optics->getMatrix(p.energyLoss, p.mass, p.charge);
+        for(i = 0; i < 36; ++i) elementMatrix[i] = matrix.GetMatrixArray()[i];
+        m = elementMatrix;
+      }
+
+      for(j = 0; j < 6; ++j)
+      {
+        vec[j] = 0.0;
+        for(i = 0; i < 6; ++i) vec[j] += p.vec[i]*m[i*6 + j];
+      }
+
+      p.vec[0] = vec[0] + element.x;
+      p.vec[1] = vec[1] + element.tx;
+      p.vec[2] = vec[2] + element.y;
+      p.vec[3] = vec[3] + element.ty;
+      p.vec[4] = vec[4];
+      p.vec[5] = vec[5];
+
+      x = p.vec[0]*URAD;
+      tx = atan(p.vec[1])*URAD;
+      y = p.vec[2]*URAD;
+      ty = atan(p.vec[3])*URAD;
+
+      if(element.aperture && !(element.optics->isInside(p.x, p.y) && element.optics->isInside(x, y)))
+      {
+        p.stopped = kTRUE;
+        --alive;
+        continue;
+      }
+
+      if(p.searching && element.s >= fDistance)
+      {
+        p.searching = kFALSE;
+        l = element.s - p.s;
+        if(l != 0.0)
+        {
+          p.found = kTRUE;
+          p.hitX = p.x + (fDistance - p.s)*(x - p.x)/l;
+          p.hitY = p.y + (fDistance - p.s)*(y - p.y)/l;
+          p.hitTX = p.tx;
+          p.hitTY = p.ty;
+          p.hitS = fDistance;
+        }
+      }
+
+      p.x = x;
+      p.tx = tx;
+      p.y = y;
+      p.ty = ty;
+      p.s = element.s;
+    }
+  }
 
-    mother = candidate;
-    candidate = static_cast<Candidate*>(candidate->Clone());
-    candidate->Position.SetXYZT(particle.getX(), particle.getY(), particle.getS(), time);
-    candidate->Momentum.SetPxPyPzE(particle.getTX(), particle.getTY(), 0.0, particle.getE());
+  for(itParticle = fParticles.begin(); itParticle != fParticles.end(); ++itParticle)
+  {
+    TBeamParticle &p = *itParticle;
+    if(p.stopped) continue;
+
+    // without propagation, Hector keeps the position at the end of the beam line
+    if(!p.found)
+    {
+      p.hitX = p.x;
+      p.hitTX = p.tx;
+      p.hitY = p.y;
+      p.hitTY = p.ty;
+    }
+
+    mother = p.candidate;
+    candidate = static_cast<Candidate*>(mother->Clone());
+    candidate->Position.SetXYZT(p.hitX, p.hitY, p.hitS, p.time);
+    candidate->Momentum.SetPxPyPzE(p.hitTX, p.hitTY, 0.0, p.energy);
     candidate->AddCandidate(mother);
 
     fOutputArray->Add(candidate);
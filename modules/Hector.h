@@ -29,9 +29,13 @@
 
 #include "classes/DelphesModule.h"
 
+#include <vector>
+
 class TIterator;
 class TObjArray;
 class H_BeamLine;
+class H_OpticalElement;
+class Candidate;
 
 class Hector: public DelphesModule
 {
@@ -55,6 +59,36 @@ private:
 
   H_BeamLine *fBeamLine;
 
+#if !defined(__CINT__) && !defined(__CLING__)
+  struct TElement
+  {
+    const H_OpticalElement *optics;
+    // element offsets and position of the element exit
+    Double_t x, tx, y, ty, s;
+    Bool_t aperture;
+    // matrix of the elements that don't depend on the particle,
+    // the other ones are computed for every particle
+    Bool_t fixed;
+    Double_t matrix[36];
+  };
+
+  struct TBeamParticle
+  {
+    Candidate *candidate;
+    Double_t time, energy;
+    Float_t mass, charge, energyLoss;
+    // transport vector and position before the current element
+    Double_t vec[6];
+    Double_t x, tx, y, ty, s;
+    // position at the requested distance
+    Double_t hitX, hitTX, hitY, hitTY, hitS;
+    Bool_t searching, found, stopped;
+  };
+
+  std::vector< TElement > fElements; //!
+  std::vector< TBeamParticle > fParticles; //!
+#endif
+
   TIterator *fItInputArray; //!
 
   const TObjArray *fInputArray; //!
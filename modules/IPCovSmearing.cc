@@ -254,9 +254,10 @@ void IPCovSmearing::Process()
     Candidate* smeared_track = static_cast<Candidate*>(track->Clone());
 
     // copy track parameters to the track
-    float* trkPar = smeared_track->trkPar;
+    CandidateTrackParameters& trackParameters = smeared_track->TrackParameters();
+    float* trkPar = trackParameters.trkPar;
     for (int iii = 0; iii < 5; iii++) trkPar[iii] = smeared(iii);
-    float* cov_array = smeared_track->trkCov;
+    float* cov_array = trackParameters.trkCov;
 
     // copy covariance matrix to the track
     const CovMatrix& cov = fCovarianceMatrices.at(bins.first).at(bins.second);
@@ -32,6 +32,7 @@
 
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesArrayView.h"
 #include "classes/DelphesFormula.h"
 
 #include "ExRootAnalysis/ExRootResult.h"
@@ -81,9 +82,7 @@ Int_t IsolationClassifier::GetCategory(TObject *object)
 //------------------------------------------------------------------------------
 
 Isolation::Isolation() :
-  fClassifier(0), fFilter(0),
-  fItIsolationInputArray(0), fItCandidateInputArray(0),
-  fItRhoInputArray(0)
+  fClassifier(0), fFilter(0)
 {
   fClassifier = new IsolationClassifier;
 }
@@ -113,18 +112,15 @@ void Isolation::Init()
   // import input array(s)
 
   fIsolationInputArray = ImportArray(GetString("IsolationInputArray", "Delphes/partons"));
-  fItIsolationInputArray = fIsolationInputArray->MakeIterator();
 
   fFilter = new ExRootFilter(fIsolationInputArray);
 
   fCandidateInputArray = ImportArray(GetString("CandidateInputArray", "Calorimeter/electrons"));
-  fItCandidateInputArray = fCandidateInputArray->MakeIterator();
 
   rhoInputArrayName = GetString("RhoInputArray", "");
   if(rhoInputArrayName[0] != '\0')
   {
     fRhoInputArray = ImportArray(rhoInputArrayName);
-    fItRhoInputArray = fRhoInputArray->MakeIterator();
   }
   else
   {
@@ -140,17 +136,13 @@ void Isolation::Init()
 
 void Isolation::Finish()
 {
-  if(fItRhoInputArray) delete fItRhoInputArray;
   if(fFilter) delete fFilter;
-  if(fItCandidateInputArray) delete fItCandidateInputArray;
-  if(fItIsolationInputArray) delete fItIsolationInputArray;
 }
 
 //------------------------------------------------------------------------------
 
 void Isolation::Process()
 {
-  Candidate *candidate, *isolation, *object;
   TObjArray *isolationArray;
   Double_t sumCharged, sumNeutral, sumAllParticles, sumChargedPU, sumDBeta, ratioDBeta, sumRhoCorr, ratioRhoCorr;
   Int_t counter;
@@ -163,11 +155,10 @@ void Isolation::Process()
 
   if(isolationArray == 0) return;
 
-  TIter itIsolationArray(isolationArray);
+  CandidateArrayView isolationView(isolationArray);
 
   // loop over all input jets
-  fItCandidateInputArray->Reset();
-  while((candidate = static_cast<Candidate*>(fItCandidateInputArray->Next())))
+  for(Candidate *candidate : CandidateArrayView(fCandidateInputArray))
   {
     const TLorentzVector &candidateMomentum = candidate->Momentum;
     eta = TMath::Abs(candidateMomentum.Eta());
@@ -176,8 +167,7 @@ void Isolation::Process()
     rho = 0.0;
     if(fRhoInputArray)
     {
-      fItRhoInputArray->Reset();
-      while((object = static_cast<Candidate*>(fItRhoInputArray->Next())))
+      for(Candidate *object : CandidateArrayView(fRhoInputArray))
       {
         if(eta >= object->Edges[0] && eta < object->Edges[1])
         {
@@ -194,9 +184,8 @@ void Isolation::Process()
     sumAllParticles = 0.0;
    
     counter = 0;
-    itIsolationArray.Reset();
     
-    while((isolation = static_cast<Candidate*>(itIsolationArray.Next())))
+    for(Candidate *isolation : isolationView)
     {
       const TLorentzVector &isolationMomentum = isolation->Momentum;
 
@@ -221,8 +210,7 @@ void Isolation::Process()
     rho = 0.0;
     if(fRhoInputArray)
     {
-      fItRhoInputArray->Reset();
-      while((object = static_cast<Candidate*>(fItRhoInputArray->Next())))
+      for(Candidate *object : CandidateArrayView(fRhoInputArray))
       {
         if(eta >= object->Edges[0] && eta < object->Edges[1])
         {
@@ -261,8 +261,8 @@ void JetFlavorAssociation::GetAlgoFlavor(Candidate *jet, TObjArray *partonArray,
         // partons are only quarks || gluons
         int daughterFlavor1 = -1;
         int daughterFlavor2 = -1;
-        if(parton->D1 != -1) daughterFlavor1 = TMath::Abs(static_cast<Candidate *>(fParticleInputArray->At(parton->D1))->PID);
-        if(parton->D2 != -1) daughterFlavor2 = TMath::Abs(static_cast<Candidate *>(fParticleInputArray->At(parton->D2))->PID);
+        if(parton->D1 != -1) daughterFlavor1 = TMath::Abs(GetFactory()->GetGenParticle(fParticleInputArray, parton->D1)->PID);
+        if(parton->D2 != -1) daughterFlavor2 = TMath::Abs(GetFactory()->GetGenParticle(fParticleInputArray, parton->D2)->PID);
         if((daughterFlavor1 == 1 || daughterFlavor1 == 2 || daughterFlavor1 == 3 || daughterFlavor1 == 4 || daughterFlavor1 == 5 || daughterFlavor1 == 21)) daughterCounter++;
         if((daughterFlavor2 == 1 || daughterFlavor2 == 2 || daughterFlavor2 == 3 || daughterFlavor2 == 4 || daughterFlavor1 == 5 || daughterFlavor2 == 21)) daughterCounter++;
       }
@@ -370,12 +370,12 @@ void JetFlavorAssociation::GetPhysicsFlavor(Candidate *jet, TObjArray *partonArr
 
       if(parton->M1 != -1)
       {
-        mother1 = static_cast<Candidate *>(fParticleInputArray->At(parton->M1));
+        mother1 = GetFactory()->GetGenParticle(fParticleInputArray, parton->M1);
         if(mother1 && motherCounter > 0 && mother1->Momentum.DeltaR(tempParton->Momentum) < 0.001) continue;
       }
       if(parton->M2 != -1)
       {
-        mother2 = static_cast<Candidate *>(fParticleInputArray->At(parton->M2));
+        mother2 = GetFactory()->GetGenParticle(fParticleInputArray, parton->M2);
         if(mother2 && motherCounter > 0 && mother2->Momentum.DeltaR(tempParton->Momentum) < 0.001) continue;
       }
       // mother is the initialParton --> OK
@@ -37,6 +37,7 @@
 #include "modules/ImpactParameterSmearing.h"
 #include "modules/IPCovSmearing.h"
 #include "modules/TimeSmearing.h"
+#include "modules/DetectorResponse.h"
 #include "modules/SimpleCalorimeter.h"
 #include "modules/Calorimeter.h"
 #include "modules/Isolation.h"
@@ -86,6 +87,7 @@
 #pragma link C++ class ImpactParameterSmearing+;
 #pragma link C++ class IPCovSmearing+;
 #pragma link C++ class TimeSmearing+;
+#pragma link C++ class DetectorResponse+;
 #pragma link C++ class SimpleCalorimeter+;
 #pragma link C++ class Calorimeter+;
 #pragma link C++ class Isolation+;
@@ -307,7 +307,7 @@ void ParticlePropagator::Process()
         float theta = 2.*TMath::ATan(TMath::Exp(-eta));
         if(q<1E-9) qoverp *= -1;
  
-        float* trkPar = candidate->trkPar;
+        float* trkPar = candidate->TrackParameters().trkPar;
         trkPar[D0]    = (xd*py - yd*px)/pt * 1e3;
         trkPar[Z0]    = zd * 1e3;
         trkPar[PHI]   = candidateMomentum.Phi();
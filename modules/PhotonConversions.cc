@@ -37,7 +37,6 @@
 #include "ExRootAnalysis/ExRootClassifier.h"
 
 #include "TMath.h"
-#include "TF1.h"
 #include "TString.h"
 #include "TFormula.h"
 #include "TRandom3.h"
@@ -56,9 +55,8 @@ using namespace std;
 //------------------------------------------------------------------------------
 
 PhotonConversions::PhotonConversions() :
-  fItInputArray(0), fConversionMap(0), fDecayXsec(0)
+  fItInputArray(0), fConversionMap(0)
 {
-  fDecayXsec = new TF1;
   fConversionMap = new DelphesCylindricalFormula;
 }
 
@@ -84,12 +82,15 @@ void PhotonConversions::Init()
 
   fConversionMap->Compile(GetString("ConversionMap", "0.0"));
 
-#if  ROOT_VERSION_CODE < ROOT_VERSION(6,04,00)
-  fDecayXsec->Compile("1.0 - 4.0/3.0 * x * (1.0 - x)");
-#else
-  fDecayXsec->GetFormula()->Compile("1.0 - 4.0/3.0 * x * (1.0 - x)");
-#endif
-  fDecayXsec->SetRange(0.0, 1.0);
+  // number of (eta, phi) rays on which the conversion map is integrated
+  fEtaBins = GetInt("EtaBins", 100);
+  fPhiBins = GetInt("PhiBins", 36);
+
+  if(fEtaBins < 1) fEtaBins = 1;
+  if(fPhiBins < 1) fPhiBins = 1;
+
+  FillRayTable();
+  FillSharingTable();
 
   // import array with output from filter/classifier module
 
@@ -106,26 +107,106 @@ void PhotonConversions::Init()
 void PhotonConversions::Finish()
 {
   if(fItInputArray) delete fItInputArray;
-  if(fDecayXsec) delete fDecayXsec;
   if(fConversionMap) delete fConversionMap;
 }
 
 //------------------------------------------------------------------------------
 
+void PhotonConversions::FillRayTable()
+{
+  Int_t ray, etaBin, phiBin, nsteps, i;
+  Double_t eta, phi, cosh, tanh, length, step, r, z, integral;
+
+  // photons coming from the origin cross the cylinder along straight rays,
+  // the conversion rate is summed along each ray with the same steps as
+  // a photon flying in the direction of the centre of the (eta, phi) bin
+
+  fRayIntegral.clear();
+  fRayOffset.assign(fEtaBins*fPhiBins + 1, 0);
+
+  for(etaBin = 0; etaBin < fEtaBins; ++etaBin)
+  {
+    eta = fEtaMin + (etaBin + 0.5)*(fEtaMax - fEtaMin)/fEtaBins;
+    cosh = TMath::CosH(eta);
+    tanh = TMath::TanH(eta);
+
+    // distance from the origin to the cylinder surface
+    length = fRadius*cosh;
+    if(TMath::Abs(tanh)*length > fHalfLength) length = fHalfLength/TMath::Abs(tanh);
+
+    nsteps = Int_t(length/fStep);
+    step = nsteps > 0 ? length/nsteps : 0.0;
+
+    for(phiBin = 0; phiBin < fPhiBins; ++phiBin)
+    {
+      phi = -TMath::Pi() + (phiBin + 0.5)*2.0*TMath::Pi()/fPhiBins;
+      ray = etaBin*fPhiBins + phiBin;
+
+      fRayOffset[ray] = fRayIntegral.size();
+
+      integral = 0.0;
+      for(i = 1; i <= nsteps; ++i)
+      {
+        r = i*step/cosh;
+        z = i*step*tanh;
+        integral += fConversionMap->Eval(r, phi, z);
+        fRayIntegral.push_back(integral);
+      }
+    }
+  }
+
+  fRayOffset[fEtaBins*fPhiBins] = fRayIntegral.size();
+}
+
+//------------------------------------------------------------------------------
+
+void PhotonConversions::FillSharingTable()
+{
+  const Int_t nbins = 1000;
+  Int_t i, j;
+  Double_t u, low, high, x;
+
+  // the e+ takes a fraction x of the photon energy with
+  // probability density proportional to 1 - 4/3*x*(1 - x),
+  // its cumulative distribution is (x - 2/3*x^2 + 4/9*x^3)*9/7
+
+  fSharing.resize(nbins + 1);
+
+  fSharing[0] = 0.0;
+  fSharing[nbins] = 1.0;
+
+  for(i = 1; i < nbins; ++i)
+  {
+    u = Double_t(i)/nbins;
+    low = 0.0;
+    high = 1.0;
+    for(j = 0; j < 50; ++j)
+    {
+      x = 0.5*(low + high);
+      if((x - 2.0/3.0*x*x + 4.0/9.0*x*x*x)*9.0/7.0 < u)
+        low = x;
+      else
+        high = x;
+    }
+    fSharing[i] = 0.5*(low + high);
+  }
+}
+
+//------------------------------------------------------------------------------
+
 void PhotonConversions::Process()
 {
   Candidate *candidate, *ep, *em;
   TLorentzVector candidatePosition, candidateMomentum;
-  TVector3 pos_i;
   Double_t px, py, pz, pt, pt2, e, eta, phi;
   Double_t x, y, z, t;
   Double_t x_t, y_t, z_t, r_t;
-  Double_t x_i, y_i, z_i, r_i, phi_i;
+  Double_t x_i, y_i, z_i;
   Double_t dt, t1, t2, t3, t4;
   Double_t tmp, discr, discr2;
-  Int_t nsteps, i;
-  Double_t rate, p_conv, x1, x2;
-  Bool_t converted;
+  Int_t nsteps, i, ray, etaBin, phiBin;
+  Double_t integral, u, x1, x2;
+  vector< Double_t >::const_iterator itFirst, itLast, itStep;
 
   fItInputArray->Reset();
   while((candidate = static_cast<Candidate*>(fItInputArray->Next())))
@@ -191,67 +272,70 @@ void PhotonConversions::Process()
 
       // here starts conversion code
       nsteps = Int_t(r_t/fStep);
-
-      x_i = x;
-      y_i = y;
-      z_i = z;
+      if(nsteps < 1)
+      {
+        fOutputArray->Add(candidate);
+        continue;
+      }
 
       dt = t/nsteps;
 
-      converted = false;
+      // the photon survives k steps with probability exp(-7/9*fStep*S_k),
+      // where S_k is the sum of the conversion rates over the first k steps,
+      // so it converts at the first step where S_k exceeds -log(u)/(7/9*fStep)
+      // for a uniform random number u
 
-      for(i = 0; i < nsteps; ++i)
-      {
-        x_i += px*dt;
-        y_i += py*dt;
-        z_i += pz*dt;
-        pos_i.SetXYZ(x_i,y_i,z_i);
+      etaBin = Int_t((eta - fEtaMin)/(fEtaMax - fEtaMin)*fEtaBins);
+      phiBin = Int_t((phi + TMath::Pi())/(2.0*TMath::Pi())*fPhiBins);
+      etaBin = TMath::Max(0, TMath::Min(etaBin, fEtaBins - 1));
+      phiBin = TMath::Max(0, TMath::Min(phiBin, fPhiBins - 1));
+      ray = etaBin*fPhiBins + phiBin;
 
-        // convert photon position into cylindrical coordinates, cylindrical r,phi,z !!
+      itFirst = fRayIntegral.begin() + fRayOffset[ray];
+      itLast = fRayIntegral.begin() + fRayOffset[ray + 1];
+      if(itLast - itFirst > nsteps) itLast = itFirst + nsteps;
 
-        r_i = TMath::Sqrt(x_i*x_i + y_i*y_i);
-        phi_i = pos_i.Phi();
+      integral = -TMath::Log(gRandom->Uniform())/(7.0/9.0*fStep);
 
-        // read conversion rate/meter from card
-        rate = fConversionMap->Eval(r_i, phi_i, z_i);
-
-        // convert into conversion probability
-        p_conv = 1 - TMath::Exp(-7.0/9.0*fStep*rate);
+      itStep = upper_bound(itFirst, itLast, integral);
+      if(itStep == itLast)
+      {
+        fOutputArray->Add(candidate);
+        continue;
+      }
 
-        // case conversion occurs
-        if(gRandom->Uniform() < p_conv)
-        {
-          converted = true;
+      i = itStep - itFirst + 1;
 
-          // generate x1 and x2, the fraction of the photon energy taken resp. by e+ and e-
-          x1 = fDecayXsec->GetRandom();
-          x2 = 1 - x1;
+      x_i = x + px*dt*i;
+      y_i = y + py*dt*i;
+      z_i = z + pz*dt*i;
 
-          ep = static_cast<Candidate*>(candidate->Clone());
-          em = static_cast<Candidate*>(candidate->Clone());
+      // generate x1 and x2, the fraction of the photon energy taken resp. by e+ and e-
+      u = gRandom->Uniform()*(fSharing.size() - 1);
+      i = TMath::Min(Int_t(u), Int_t(fSharing.size()) - 2);
+      x1 = fSharing[i] + (u - i)*(fSharing[i + 1] - fSharing[i]);
+      x2 = 1 - x1;
 
-          ep->Position.SetXYZT(x_i*1.0E3, y_i*1.0E3, z_i*1.0E3, candidatePosition.T() + nsteps*dt*e*1.0E3);
-          em->Position.SetXYZT(x_i*1.0E3, y_i*1.0E3, z_i*1.0E3, candidatePosition.T() + nsteps*dt*e*1.0E3);
+      ep = static_cast<Candidate*>(candidate->Clone());
+      em = static_cast<Candidate*>(candidate->Clone());
 
-          ep->Momentum.SetPtEtaPhiE(x1*pt, eta, phi, x1*e);
-          em->Momentum.SetPtEtaPhiE(x2*pt, eta, phi, x2*e);
+      ep->Position.SetXYZT(x_i*1.0E3, y_i*1.0E3, z_i*1.0E3, candidatePosition.T() + nsteps*dt*e*1.0E3);
+      em->Position.SetXYZT(x_i*1.0E3, y_i*1.0E3, z_i*1.0E3, candidatePosition.T() + nsteps*dt*e*1.0E3);
 
-          ep->PID = -11;
-          em->PID = 11;
+      ep->Momentum.SetPtEtaPhiE(x1*pt, eta, phi, x1*e);
+      em->Momentum.SetPtEtaPhiE(x2*pt, eta, phi, x2*e);
 
-          ep->Charge = 1.0;
-          em->Charge = -1.0;
+      ep->PID = -11;
+      em->PID = 11;
 
-          ep->IsFromConversion = 1;
-          em->IsFromConversion = 1;
+      ep->Charge = 1.0;
+      em->Charge = -1.0;
 
-          fOutputArray->Add(em);
-          fOutputArray->Add(ep);
+      ep->IsFromConversion = 1;
+      em->IsFromConversion = 1;
 
-          break;
-        }
-      }
-      if(!converted) fOutputArray->Add(candidate);
+      fOutputArray->Add(em);
+      fOutputArray->Add(ep);
     }
   }
 }
@@ -29,10 +29,11 @@
 
 #include "classes/DelphesModule.h"
 
+#include <vector>
+
 class TClonesArray;
 class TIterator;
 class DelphesCylindricalFormula;
-class TF1;
 
 class PhotonConversions: public DelphesModule
 {
@@ -47,6 +48,9 @@ public:
 
 private:
 
+  void FillRayTable();
+  void FillSharingTable();
+
   Double_t fRadius, fRadius2, fHalfLength;
   Double_t fEtaMin, fEtaMax;
 
@@ -58,10 +62,20 @@ private:
 
   DelphesCylindricalFormula *fConversionMap; //!
 
-  TF1 *fDecayXsec; //!
-
   Double_t fStep;
 
+  Int_t fEtaBins, fPhiBins;
+
+#if !defined(__CINT__) && !defined(__CLING__)
+  // running sum of the conversion rate along the rays from the origin,
+  // fRayOffset[ray] is the index of the first step of each ray
+  std::vector< Double_t > fRayIntegral; //!
+  std::vector< Int_t > fRayOffset; //!
+
+  // inverse of the cumulative distribution of the e+ energy fraction
+  std::vector< Double_t > fSharing; //!
+#endif
+
   ClassDef(PhotonConversions, 1)
 };
 
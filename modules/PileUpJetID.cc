@@ -24,6 +24,7 @@
 #include "TObjArray.h"
 //#include "TDatabasePDG.h"
 #include "TLorentzVector.h"
+#include "TVector2.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -99,17 +100,122 @@ void PileUpJetID::Finish()
 
 //------------------------------------------------------------------------------
 
+void PileUpJetID::SweepParticles()
+{
+  Candidate *jet, *particle;
+  JetSums zero;
+  JetAxis axis;
+  Double_t eta, phi, dphi, deltaR, ptNeutral;
+  Int_t i, number;
+  vector< JetAxis >::const_iterator itAxis;
+
+  // sort the jet axes by eta, so that each particle is only
+  // compared with the jets in the eta range [eta - R, eta + R]
+
+  number = fJetInputArray->GetEntriesFast();
+
+  zero.sumpt = zero.sumptch = zero.sumptchpv = zero.sumptchpu = 0.;
+  zero.sumdrsqptsq = zero.sumptsq = 0.;
+  zero.nc = zero.nn = 0;
+  for (i = 0 ; i < 5 ; i++) {
+    zero.pt_ann[i] = 0.;
+  }
+
+  fJetSums.assign(number, zero);
+  fJetNeutrals.resize(number);
+  fJetAxes.clear();
+
+  for (i = 0 ; i < number ; i++) {
+    jet = static_cast<Candidate*>(fJetInputArray->At(i));
+    axis.eta = jet->Momentum.Eta();
+    axis.phi = jet->Momentum.Phi();
+    axis.index = i;
+    fJetAxes.push_back(axis);
+    fJetNeutrals[i].clear();
+  }
+
+  sort(fJetAxes.begin(), fJetAxes.end());
+
+  // tracks first and neutrals second, the sums of each jet
+  // are accumulated in the same order as in a per-jet scan
+
+  fItTrackInputArray->Reset();
+  while ((particle = static_cast<Candidate*>(fItTrackInputArray->Next()))) {
+    eta = particle->Momentum.Eta();
+    phi = particle->Momentum.Phi();
+    float pt = particle->Momentum.Pt();
+    axis.eta = eta - fParameterR;
+    for (itAxis = lower_bound(fJetAxes.begin(), fJetAxes.end(), axis) ;
+         itAxis != fJetAxes.end() && itAxis->eta <= eta + fParameterR ; ++itAxis) {
+      dphi = TVector2::Phi_mpi_pi(itAxis->phi - phi);
+      deltaR = TMath::Sqrt((itAxis->eta - eta)*(itAxis->eta - eta) + dphi*dphi);
+      if (deltaR >= fParameterR) continue;
+      float dr = deltaR;
+      JetSums &sums = fJetSums[itAxis->index];
+      sums.sumpt += pt;
+      sums.sumptch += pt;
+      if (particle->IsRecoPU) {
+	sums.sumptchpu += pt;
+      } else {
+	sums.sumptchpv += pt;
+      }
+      sums.sumdrsqptsq += dr*dr*pt*pt;
+      sums.sumptsq += pt*pt;
+      sums.nc++;
+      for (i = 0 ; i < 5 ; i++) {
+	if (dr > 0.1*i && dr < 0.1*(i+1)) {
+	  sums.pt_ann[i] += pt;
+	}
+      }
+    }
+  }
+
+  fItNeutralInputArray->Reset();
+  while ((particle = static_cast<Candidate*>(fItNeutralInputArray->Next()))) {
+    eta = particle->Momentum.Eta();
+    phi = particle->Momentum.Phi();
+    ptNeutral = particle->Momentum.Pt();
+    float pt = ptNeutral;
+    axis.eta = eta - fParameterR;
+    for (itAxis = lower_bound(fJetAxes.begin(), fJetAxes.end(), axis) ;
+         itAxis != fJetAxes.end() && itAxis->eta <= eta + fParameterR ; ++itAxis) {
+      dphi = TVector2::Phi_mpi_pi(itAxis->phi - phi);
+      deltaR = TMath::Sqrt((itAxis->eta - eta)*(itAxis->eta - eta) + dphi*dphi);
+      if (deltaR >= fParameterR) continue;
+      float dr = deltaR;
+      JetSums &sums = fJetSums[itAxis->index];
+      sums.sumpt += pt;
+      sums.sumdrsqptsq += dr*dr*pt*pt;
+      sums.sumptsq += pt*pt;
+      sums.nn++;
+      for (i = 0 ; i < 5 ; i++) {
+	if (dr > 0.1*i && dr < 0.1*(i+1)) {
+	  sums.pt_ann[i] += pt;
+	}
+      }
+      if (ptNeutral > fNeutralPTMin) fJetNeutrals[itAxis->index].push_back(particle);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
 void PileUpJetID::Process()
 {
   Candidate *candidate, *constituent;
   TLorentzVector momentum, area;
+  Int_t jet;
 
-  Candidate *trk;
+  // without constituents, all the particles are assigned to the jets at once
+  if (!fUseConstituents) SweepParticles();
 
   // loop over all input candidates
+  jet = -1;
   fItJetInputArray->Reset();
   while((candidate = static_cast<Candidate*>(fItJetInputArray->Next())))
   {
+    ++jet;
+
     momentum = candidate->Momentum;
     area = candidate->Area;
 
@@ -163,18 +269,19 @@ void PileUpJetID::Process()
 	}
 	float tow_sumT = 0;
 	float tow_sumW = 0;
-	for (int i = 0 ; i < constituent->ECalEnergyTimePairs.size() ; i++) {
-	  float w = TMath::Sqrt(constituent->ECalEnergyTimePairs[i].first);
+	const std::vector< std::pair< Float_t, Float_t > > &timePairs = constituent->GetCalorimeter().ECalEnergyTimePairs;
+	for (int i = 0 ; i < timePairs.size() ; i++) {
+	  float w = TMath::Sqrt(timePairs[i].first);
 	  if (fAverageEachTower) {
-            tow_sumT += w*constituent->ECalEnergyTimePairs[i].second;
+            tow_sumT += w*timePairs[i].second;
             tow_sumW += w;
 	  } else {
-	    sumT0 += w*constituent->ECalEnergyTimePairs[i].second;
-	    sumT1 += w*gRandom->Gaus(constituent->ECalEnergyTimePairs[i].second,0.001);
-	    sumT10 += w*gRandom->Gaus(constituent->ECalEnergyTimePairs[i].second,0.010);
-	    sumT20 += w*gRandom->Gaus(constituent->ECalEnergyTimePairs[i].second,0.020);
-	    sumT30 += w*gRandom->Gaus(constituent->ECalEnergyTimePairs[i].second,0.030);
-	    sumT40 += w*gRandom->Gaus(constituent->ECalEnergyTimePairs[i].second,0.040);
+	    sumT0 += w*timePairs[i].second;
+	    sumT1 += w*gRandom->Gaus(timePairs[i].second,0.001);
+	    sumT10 += w*gRandom->Gaus(timePairs[i].second,0.010);
+	    sumT20 += w*gRandom->Gaus(timePairs[i].second,0.020);
+	    sumT30 += w*gRandom->Gaus(timePairs[i].second,0.030);
+	    sumT40 += w*gRandom->Gaus(timePairs[i].second,0.040);
 	    sumWeightsForT += w;
 	    candidate->NTimeHits++;
 	  }
@@ -192,43 +299,17 @@ void PileUpJetID::Process()
       }
     } else {
       // Not using constituents, using dr
-      fItTrackInputArray->Reset();
-      while ((trk = static_cast<Candidate*>(fItTrackInputArray->Next()))) {
-	if (trk->Momentum.DeltaR(candidate->Momentum) < fParameterR) {
-	  float pt = trk->Momentum.Pt();
-	  sumpt += pt;
-	  sumptch += pt;
-	  if (trk->IsRecoPU) {
-	    sumptchpu += pt;
-	  } else {
-	    sumptchpv += pt;
-	  }
-	  float dr = candidate->Momentum.DeltaR(trk->Momentum);
-	  sumdrsqptsq += dr*dr*pt*pt;
-	  sumptsq += pt*pt;
-	  nc++;
-	  for (int i = 0 ; i < 5 ; i++) {
-	    if (dr > 0.1*i && dr < 0.1*(i+1)) {
-	      pt_ann[i] += pt;
-	    }
-	  }
-	}
-      }
-      fItNeutralInputArray->Reset();
-      while ((constituent = static_cast<Candidate*>(fItNeutralInputArray->Next()))) {
-	if (constituent->Momentum.DeltaR(candidate->Momentum) < fParameterR) {
-	  float pt = constituent->Momentum.Pt();
-	  sumpt += pt;
-	  float dr = candidate->Momentum.DeltaR(constituent->Momentum);
-	  sumdrsqptsq += dr*dr*pt*pt;
-	  sumptsq += pt*pt;
-	  nn++;
-	  for (int i = 0 ; i < 5 ; i++) {
-	    if (dr > 0.1*i && dr < 0.1*(i+1)) {
-            pt_ann[i] += pt;
-	    }
-	  }
-	}
+      const JetSums &sums = fJetSums[jet];
+      sumpt = sums.sumpt;
+      sumptch = sums.sumptch;
+      sumptchpv = sums.sumptchpv;
+      sumptchpu = sums.sumptchpu;
+      sumdrsqptsq = sums.sumdrsqptsq;
+      sumptsq = sums.sumptsq;
+      nc = sums.nc;
+      nn = sums.nn;
+      for (int i = 0 ; i < 5 ; i++) {
+	pt_ann[i] = sums.pt_ann[i];
       }
     }
 
@@ -293,12 +374,9 @@ void PileUpJetID::Process()
 	  }
 	}
       } else { // use DeltaR
-	fItNeutralInputArray->Reset();
-	while ((constituent = static_cast<Candidate*>(fItNeutralInputArray->Next()))) {
-	  if (constituent->Momentum.DeltaR(candidate->Momentum) < fParameterR && constituent->Momentum.Pt() > fNeutralPTMin) {
-	    fNeutralsInPassingJets->Add(constituent);
-	    //            cout << "    Constitutent added Pt Eta Charge " << constituent->Momentum.Pt() << " " << constituent->Momentum.Eta() << " " << constituent->Charge << endl;
-	  }
+	const vector< Candidate * > &neutrals = fJetNeutrals[jet];
+	for (size_t i = 0 ; i < neutrals.size() ; i++) {
+	  fNeutralsInPassingJets->Add(neutrals[i]);
 	}
       }
     }
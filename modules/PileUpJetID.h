@@ -13,8 +13,11 @@
 #include "classes/DelphesModule.h"
 
 #include <deque>
+#include <vector>
+#include <utility>
 
 class TObjArray;
+class Candidate;
 class DelphesFormula;
 
 class PileUpJetID: public DelphesModule
@@ -30,6 +33,8 @@ public:
 
 private:
 
+  void SweepParticles();
+
   Double_t fJetPTMin;
   Double_t fParameterR;
 
@@ -104,6 +109,30 @@ MeanSqDeltaR
   TObjArray *fOutputArray; //!
   TObjArray *fNeutralsInPassingJets; // SCZ
 
+#if !defined(__CINT__) && !defined(__CLING__)
+  // sums over the particles within fParameterR of each jet
+  struct JetSums
+  {
+    float sumpt, sumptch, sumptchpv, sumptchpu, sumdrsqptsq, sumptsq;
+    int nc, nn;
+    float pt_ann[5];
+  };
+
+  std::vector< JetSums > fJetSums; //!
+
+  // neutrals above fNeutralPTMin within fParameterR of each jet, in input order
+  std::vector< std::vector< Candidate * > > fJetNeutrals; //!
+
+  struct JetAxis
+  {
+    Double_t eta, phi;
+    Int_t index;
+    bool operator<(const JetAxis &axis) const { return eta < axis.eta; }
+  };
+
+  // jet axes sorted by eta
+  std::vector< JetAxis > fJetAxes; //!
+#endif
 
   ClassDef(PileUpJetID, 2)
 };
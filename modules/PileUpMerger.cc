@@ -30,6 +30,7 @@
 #include "classes/DelphesFactory.h"
 #include "classes/DelphesTF2.h"
 #include "classes/DelphesPileUpReader.h"
+#include "classes/DelphesPDGTable.h"
 
 #include "ExRootAnalysis/ExRootResult.h"
 #include "ExRootAnalysis/ExRootFilter.h"
@@ -40,7 +41,6 @@
 #include "TFormula.h"
 #include "TRandom3.h"
 #include "TObjArray.h"
-#include "TDatabasePDG.h"
 #include "TLorentzVector.h"
 
 #include <algorithm>
@@ -53,7 +53,8 @@ using namespace std;
 //------------------------------------------------------------------------------
 
 PileUpMerger::PileUpMerger() :
-  fFunction(0), fReader(0), fItInputArray(0)
+  fStopPrefetch(false), fCacheSize(0), fCacheUsed(0), fPrefetchSize(0),
+  fEntryRandom(0), fFunction(0), fReader(0), fItInputArray(0)
 {
   fFunction = new DelphesTF2;
 }
@@ -63,6 +64,8 @@ PileUpMerger::PileUpMerger() :
 
 PileUpMerger::~PileUpMerger()
 {
+  StopPrefetch();
+  if(fEntryRandom) delete fEntryRandom;
   delete fFunction;
 }
 
@@ -71,6 +74,7 @@ PileUpMerger::~PileUpMerger()
 void PileUpMerger::Init()
 {
   const char *fileName;
+  Int_t tableBins;
 
   fPileUpDistribution = GetInt("PileUpDistribution", 0);
 
@@ -89,9 +93,35 @@ void PileUpMerger::Init()
   fFunction->Compile(GetString("VertexDistributionFormula", "0.0"));
   fFunction->SetRange(-fZVertexSpread, -fTVertexSpread, fZVertexSpread, fTVertexSpread);
 
+  // with VertexTableBins > 0, sample the vertex distribution from a table
+  // built once here instead of TF2::GetRandom2
+  tableBins = GetInt("VertexTableBins", 0);
+  if(tableBins > 0) fFunction->Tabulate(tableBins, tableBins);
+  fFunction->ValidateTable(GetInt("VertexTableValidation", 0));
+
   fileName = GetString("PileUpFile", "MinBias.pileup");
   fReader = new DelphesPileUpReader(fileName);
 
+  // memory (in MB) used to keep decoded pile-up events,
+  // a cached event is reused with a new vertex and rotation
+  fCacheSize = Long64_t(GetDouble("CacheSize", 0.0)*1048576.0);
+  fCacheUsed = 0;
+  fCache.clear();
+
+  // number of pile-up events read ahead by a background thread,
+  // the entries are then drawn from their own random generator
+  fPrefetchSize = GetInt("PrefetchSize", 0);
+  if(fPrefetchSize > 0)
+  {
+    // load the particle table before it is used by the thread
+    DelphesPDGTable::Instance();
+    fEntryRandom = new TRandom3(gRandom->Integer(kMaxInt) + 1);
+    fStopPrefetch = false;
+    fPrefetchError.clear();
+    fQueue.clear();
+    fPrefetchThread = thread(&PileUpMerger::PrefetchLoop, this);
+  }
+
   // import input array
   fInputArray = ImportArray(GetString("InputArray", "Delphes/stableParticles"));
   fItInputArray = fInputArray->MakeIterator();
@@ -105,18 +135,116 @@ void PileUpMerger::Init()
 
 void PileUpMerger::Finish()
 {
+  StopPrefetch();
   if(fReader) delete fReader;
+  fReader = 0;
+  fCache.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMerger::StopPrefetch()
+{
+  if(!fPrefetchThread.joinable()) return;
+  {
+    lock_guard< mutex > lock(fQueueMutex);
+    fStopPrefetch = true;
+  }
+  fQueueNotFull.notify_all();
+  fPrefetchThread.join();
+  fQueue.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMerger::PrefetchLoop()
+{
+  Long64_t allEntries, entry;
+
+  try
+  {
+    allEntries = fReader->GetEntries();
+    while(true)
+    {
+      do
+      {
+        entry = TMath::Nint(fEntryRandom->Rndm()*allEntries);
+      }
+      while(entry >= allEntries);
+
+      const TPileUpEvent &pileUpEvent = GetPileUpEvent(entry);
+
+      unique_lock< mutex > lock(fQueueMutex);
+      while(!fStopPrefetch && Int_t(fQueue.size()) >= fPrefetchSize)
+      {
+        fQueueNotFull.wait(lock);
+      }
+      if(fStopPrefetch) return;
+      fQueue.push_back(pileUpEvent);
+      fQueueNotEmpty.notify_one();
+    }
+  }
+  catch(exception &e)
+  {
+    lock_guard< mutex > lock(fQueueMutex);
+    fPrefetchError = e.what();
+    fQueueNotEmpty.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMerger::NextPileUpEvent(TPileUpEvent &event)
+{
+  unique_lock< mutex > lock(fQueueMutex);
+  while(fQueue.empty() && fPrefetchError.empty())
+  {
+    fQueueNotEmpty.wait(lock);
+  }
+  if(fQueue.empty()) throw runtime_error(fPrefetchError);
+  event.swap(fQueue.front());
+  fQueue.pop_front();
+  fQueueNotFull.notify_one();
+}
+
+//------------------------------------------------------------------------------
+
+const PileUpMerger::TPileUpEvent &PileUpMerger::GetPileUpEvent(Long64_t entry)
+{
+  const DelphesPDGTable &pdg = DelphesPDGTable::Instance();
+  map< Long64_t, TPileUpEvent >::iterator itCache;
+  TPileUpParticle particle;
+  Long64_t size;
+
+  itCache = fCache.find(entry);
+  if(itCache != fCache.end()) return itCache->second;
+
+  fEvent.clear();
+
+  fReader->ReadEntry(entry);
+  while(fReader->ReadParticle(particle.pid,
+    particle.x, particle.y, particle.z, particle.t,
+    particle.px, particle.py, particle.pz, particle.e))
+  {
+    particle.charge = pdg.GetCharge(particle.pid);
+    particle.mass = pdg.GetMass(particle.pid);
+    fEvent.push_back(particle);
+  }
+
+  size = fEvent.size()*sizeof(TPileUpParticle) + sizeof(TPileUpEvent);
+  if(fCacheUsed + size > fCacheSize) return fEvent;
+
+  fCacheUsed += size;
+  itCache = fCache.insert(make_pair(entry, fEvent)).first;
+  return itCache->second;
 }
 
 //------------------------------------------------------------------------------
 
 void PileUpMerger::Process()
 {
-  TDatabasePDG *pdg = TDatabasePDG::Instance();
-  TParticlePDG *pdgParticle;
-  Int_t pid;
+  TPileUpEvent::const_iterator itEvent;
   Float_t x, y, z, t, vx, vy;
-  Float_t px, py, pz, e;
   Double_t dz, dphi, dt;
   Int_t numberOfEvents, event, numberOfParticles;
   Long64_t allEntries, entry;
@@ -129,7 +257,7 @@ void PileUpMerger::Process()
 
   // --- Deal with primary vertex first  ------
 
-  fFunction->GetRandom2(dz, dt);
+  fFunction->GetTabulatedRandom2(dz, dt);
 
   dt *= c_light*1.0E3; // necessary in order to make t in mm/c
   dz *= 1.0E3; // necessary in order to make z in mm
@@ -178,17 +306,24 @@ void PileUpMerger::Process()
 
   for(event = 0; event < numberOfEvents; ++event)
   {
-    do
+    if(fPrefetchSize > 0)
+    {
+      NextPileUpEvent(fReadyEvent);
+    }
+    else
     {
-      entry = TMath::Nint(gRandom->Rndm()*allEntries);
+      do
+      {
+        entry = TMath::Nint(gRandom->Rndm()*allEntries);
+      }
+      while(entry >= allEntries);
     }
-    while(entry >= allEntries);
 
-    fReader->ReadEntry(entry);
+    const TPileUpEvent &pileUpEvent = fPrefetchSize > 0 ? fReadyEvent : GetPileUpEvent(entry);
 
    // --- Pile-up vertex smearing
 
-    fFunction->GetRandom2(dz, dt);
+    fFunction->GetTabulatedRandom2(dz, dt);
 
     dt *= c_light*1.0E3; // necessary in order to make t in mm/c
     dz *= 1.0E3; // necessary in order to make z in mm
@@ -198,25 +333,26 @@ void PileUpMerger::Process()
     vx = 0.0;
     vy = 0.0;
     numberOfParticles = 0;
-    while(fReader->ReadParticle(pid, x, y, z, t, px, py, pz, e))
+    for(itEvent = pileUpEvent.begin(); itEvent != pileUpEvent.end(); ++itEvent)
     {
       candidate = factory->NewCandidate();
 
-      candidate->PID = pid;
+      candidate->PID = itEvent->pid;
 
       candidate->Status = 1;
 
-      pdgParticle = pdg->GetParticle(pid);
-      candidate->Charge = pdgParticle ? Int_t(pdgParticle->Charge()/3.0) : -999;
-      candidate->Mass = pdgParticle ? pdgParticle->Mass() : -999.9;
+      candidate->Charge = itEvent->charge;
+      candidate->Mass = itEvent->mass;
 
       candidate->IsPU = 1;
 
-      candidate->Momentum.SetPxPyPzE(px, py, pz, e);
+      candidate->Momentum.SetPxPyPzE(itEvent->px, itEvent->py, itEvent->pz, itEvent->e);
       candidate->Momentum.RotateZ(dphi);
 
-      x -= fInputBeamSpotX;
-      y -= fInputBeamSpotY;
+      x = itEvent->x - fInputBeamSpotX;
+      y = itEvent->y - fInputBeamSpotY;
+      z = itEvent->z;
+      t = itEvent->t;
       candidate->Position.SetXYZT(x, y, z + dz, t + dt);
       candidate->Position.RotateZ(dphi);
       candidate->Position += TLorentzVector(fOutputBeamSpotX, fOutputBeamSpotY, 0.0, 0.0);
@@ -29,9 +29,21 @@
 
 #include "classes/DelphesModule.h"
 
+#include <map>
+#include <deque>
+#include <vector>
+#include <string>
+
+#if !defined(__CINT__) && !defined(__CLING__)
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#endif
+
 class TObjArray;
 class DelphesPileUpReader;
 class DelphesTF2;
+class TRandom3;
 
 class PileUpMerger: public DelphesModule
 {
@@ -57,6 +69,45 @@ private:
   Double_t fOutputBeamSpotX;
   Double_t fOutputBeamSpotY;
 
+#if !defined(__CINT__) && !defined(__CLING__)
+  struct TPileUpParticle
+  {
+    Int_t pid, charge;
+    Float_t mass;
+    Float_t x, y, z, t;
+    Float_t px, py, pz, e;
+  };
+
+  typedef std::vector< TPileUpParticle > TPileUpEvent;
+
+  const TPileUpEvent &GetPileUpEvent(Long64_t entry);
+
+  // decoded pile-up events, kept until the cache size limit is reached
+  std::map< Long64_t, TPileUpEvent > fCache; //!
+  TPileUpEvent fEvent; //!
+
+  void PrefetchLoop();
+  void StopPrefetch();
+  void NextPileUpEvent(TPileUpEvent &event);
+
+  // background thread reading the next pile-up events into fQueue
+  std::thread fPrefetchThread; //!
+  std::mutex fQueueMutex; //!
+  std::condition_variable fQueueNotFull; //!
+  std::condition_variable fQueueNotEmpty; //!
+  std::deque< TPileUpEvent > fQueue; //!
+  TPileUpEvent fReadyEvent; //!
+  std::string fPrefetchError; //!
+  bool fStopPrefetch; //!
+#endif
+
+  Long64_t fCacheSize;
+  Long64_t fCacheUsed;
+
+  Int_t fPrefetchSize;
+
+  TRandom3 *fEntryRandom; //!
+
   DelphesTF2 *fFunction; //!
 
   DelphesPileUpReader *fReader; //!
@@ -30,6 +30,8 @@
 #include "classes/DelphesFactory.h"
 #include "classes/DelphesTF2.h"
 #include "classes/DelphesPileUpReader.h"
+#include "classes/DelphesPDGTable.h"
+#include "classes/DelphesPythia8Seed.h"
 
 #include "ExRootAnalysis/ExRootResult.h"
 #include "ExRootAnalysis/ExRootFilter.h"
@@ -42,7 +44,6 @@
 #include "TFormula.h"
 #include "TRandom3.h"
 #include "TObjArray.h"
-#include "TDatabasePDG.h"
 #include "TLorentzVector.h"
 
 #include <algorithm>
@@ -55,6 +56,7 @@ using namespace std;
 //------------------------------------------------------------------------------
 
 PileUpMergerPythia8::PileUpMergerPythia8() :
+  fStopWorkers(false), fPoolSize(0), fPoolRefresh(0), fPoolThreads(0), fQueueSize(0),
   fFunction(0), fPythia(0), fItInputArray(0)
 {
   fFunction = new DelphesTF2;
@@ -64,6 +66,7 @@ PileUpMergerPythia8::PileUpMergerPythia8() :
 
 PileUpMergerPythia8::~PileUpMergerPythia8()
 {
+  StopWorkers();
   delete fFunction;
 }
 
@@ -72,6 +75,8 @@ PileUpMergerPythia8::~PileUpMergerPythia8()
 void PileUpMergerPythia8::Init()
 {
   const char *fileName;
+  Int_t tableBins, seed, i;
+  stringstream seedCommand;
 
   fPileUpDistribution = GetInt("PileUpDistribution", 0);
 
@@ -90,10 +95,72 @@ void PileUpMergerPythia8::Init()
   fFunction->Compile(GetString("VertexDistributionFormula", "0.0"));
   fFunction->SetRange(-fZVertexSpread, -fTVertexSpread, fZVertexSpread, fTVertexSpread);
 
+  // with VertexTableBins > 0, sample the vertex distribution from a table
+  // built once here instead of TF2::GetRandom2
+  tableBins = GetInt("VertexTableBins", 0);
+  if(tableBins > 0) fFunction->Tabulate(tableBins, tableBins);
+  fFunction->ValidateTable(GetInt("VertexTableValidation", 0));
+
   fileName = GetString("ConfigFile", "MinBias.cmnd");
   fPythia = new Pythia8::Pythia();
   fPythia->readFile(fileName);
 
+  // number of minimum-bias events kept in memory (0 = generate every
+  // pile-up interaction in Process), number of pool events replaced
+  // by new ones at every event and number of generator threads;
+  // each pool event is used on average MeanPileUp/PoolRefresh times,
+  // so the default generates ten times fewer events than without pool,
+  // while PoolRefresh = MeanPileUp only moves the generation to the threads
+  fPoolSize = GetInt("PoolSize", 0);
+  fPoolRefresh = GetInt("PoolRefresh", TMath::Max(1, TMath::Nint(0.1*fMeanPileUp)));
+  fPoolThreads = GetInt("PoolThreads", 1);
+
+  if(fPoolSize > 0)
+  {
+    if(fPoolRefresh < 0) fPoolRefresh = 0;
+    if(fPoolRefresh > fPoolSize) fPoolRefresh = fPoolSize;
+    if(fPoolThreads < 1) fPoolThreads = 1;
+    fQueueSize = TMath::Max(2, fPoolRefresh/fPoolThreads + 1);
+
+    // each worker gets the seed of the configuration file plus its number
+    seed = fPythia->mode("Random:seed");
+
+    for(i = 0; i < fPoolThreads; ++i)
+    {
+      fWorkerPythia.push_back(new Pythia8::Pythia());
+      fWorkerPythia[i]->readFile(fileName);
+
+      seedCommand.str("");
+      seedCommand << "Random:seed = " << GetPythia8WorkerSeed(seed, i);
+      fWorkerPythia[i]->readString("Random:setSeed = on");
+      fWorkerPythia[i]->readString(seedCommand.str());
+      fWorkerPythia[i]->init();
+    }
+
+    // load the particle table before it is used by the threads
+    DelphesPDGTable::Instance();
+
+    fStopWorkers = false;
+    fWorkerError.clear();
+    fWorkerQueues.assign(fPoolThreads, deque< TPileUpEvent >());
+    fNextWorker = 0;
+    for(i = 0; i < fPoolThreads; ++i)
+    {
+      fWorkerThreads.push_back(thread(&PileUpMergerPythia8::WorkerLoop, this, i));
+    }
+
+    fPool.resize(fPoolSize);
+    for(i = 0; i < fPoolSize; ++i)
+    {
+      NextWorkerEvent(fPool[i]);
+    }
+    fNextSlot = 0;
+  }
+  else
+  {
+    fPythia->init();
+  }
+
   // import input array
   fInputArray = ImportArray(GetString("InputArray", "Delphes/stableParticles"));
   fItInputArray = fInputArray->MakeIterator();
@@ -107,18 +174,136 @@ void PileUpMergerPythia8::Init()
 
 void PileUpMergerPythia8::Finish()
 {
+  StopWorkers();
+  fPool.clear();
   if(fPythia) delete fPythia;
+  fPythia = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMergerPythia8::StopWorkers()
+{
+  size_t i;
+
+  {
+    lock_guard< mutex > lock(fWorkerMutex);
+    fStopWorkers = true;
+  }
+  fWorkerNotFull.notify_all();
+
+  for(i = 0; i < fWorkerThreads.size(); ++i)
+  {
+    if(fWorkerThreads[i].joinable()) fWorkerThreads[i].join();
+  }
+  fWorkerThreads.clear();
+  fWorkerQueues.clear();
+
+  for(i = 0; i < fWorkerPythia.size(); ++i)
+  {
+    delete fWorkerPythia[i];
+  }
+  fWorkerPythia.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMergerPythia8::WorkerLoop(Int_t worker)
+{
+  Pythia8::Pythia *pythia = fWorkerPythia[worker];
+  Long64_t errors = 0, timesAllowErrors = pythia->mode("Main:timesAllowErrors");
+  TPileUpEvent event;
+
+  try
+  {
+    while(true)
+    {
+      while(!pythia->next())
+      {
+        if(++errors > timesAllowErrors)
+        {
+          throw runtime_error("minimum-bias event generation aborted, too many Pythia errors");
+        }
+
+        lock_guard< mutex > lock(fWorkerMutex);
+        if(fStopWorkers) return;
+      }
+
+      FillPileUpEvent(pythia, event);
+
+      unique_lock< mutex > lock(fWorkerMutex);
+      while(!fStopWorkers && Int_t(fWorkerQueues[worker].size()) >= fQueueSize)
+      {
+        fWorkerNotFull.wait(lock);
+      }
+      if(fStopWorkers) return;
+      fWorkerQueues[worker].push_back(TPileUpEvent());
+      swap(fWorkerQueues[worker].back(), event);
+      fWorkerNotEmpty.notify_all();
+    }
+  }
+  catch(exception &e)
+  {
+    lock_guard< mutex > lock(fWorkerMutex);
+    fWorkerError = e.what();
+    fWorkerNotEmpty.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMergerPythia8::NextWorkerEvent(TPileUpEvent &event)
+{
+  Int_t worker;
+
+  // the workers take turns, so the events do not depend on their speed
+  worker = fNextWorker;
+  fNextWorker = (fNextWorker + 1) % fPoolThreads;
+
+  unique_lock< mutex > lock(fWorkerMutex);
+  while(fWorkerQueues[worker].empty() && fWorkerError.empty())
+  {
+    fWorkerNotEmpty.wait(lock);
+  }
+  if(fWorkerQueues[worker].empty()) throw runtime_error(fWorkerError);
+  swap(event, fWorkerQueues[worker].front());
+  fWorkerQueues[worker].pop_front();
+  fWorkerNotFull.notify_all();
+}
+
+//------------------------------------------------------------------------------
+
+void PileUpMergerPythia8::FillPileUpEvent(Pythia8::Pythia *pythia, TPileUpEvent &event)
+{
+  TPileUpParticle particle;
+  Int_t i;
+
+  event.size = pythia->event.size();
+  event.particles.clear();
+
+  for(i = 1; i < event.size; ++i)
+  {
+    Pythia8::Particle &pythiaParticle = pythia->event[i];
+
+    if(pythiaParticle.statusHepMC() != 1 || !pythiaParticle.isVisible() || pythiaParticle.pT() <= fPTMin) continue;
+
+    particle.pid = pythiaParticle.id();
+    particle.px = pythiaParticle.px(); particle.py = pythiaParticle.py();
+    particle.pz = pythiaParticle.pz(); particle.e = pythiaParticle.e();
+    particle.x = pythiaParticle.xProd(); particle.y = pythiaParticle.yProd();
+    particle.z = pythiaParticle.zProd(); particle.t = pythiaParticle.tProd();
+
+    event.particles.push_back(particle);
+  }
 }
 
 //------------------------------------------------------------------------------
 
 void PileUpMergerPythia8::Process()
 {
-  TDatabasePDG *pdg = TDatabasePDG::Instance();
-  TParticlePDG *pdgParticle;
-  Int_t pid, status;
+  const DelphesPDGTable &pdg = DelphesPDGTable::Instance();
+  vector< TPileUpParticle >::const_iterator itParticle;
   Float_t x, y, z, t, vx, vy;
-  Float_t px, py, pz, e;
   Double_t dz, dphi, dt;
   Int_t numberOfEvents, event, numberOfParticles, i;
   Candidate *candidate, *vertex;
@@ -130,7 +315,7 @@ void PileUpMergerPythia8::Process()
 
   // --- Deal with primary vertex first  ------
 
-  fFunction->GetRandom2(dz, dt);
+  fFunction->GetTabulatedRandom2(dz, dt);
 
   dt *= c_light*1.0E3; // necessary in order to make t in mm/c
   dz *= 1.0E3; // necessary in order to make z in mm
@@ -175,13 +360,26 @@ void PileUpMergerPythia8::Process()
       break;
   }
 
+  // replace the oldest events of the pool by new ones
+  for(i = 0; i < fPoolRefresh && fPoolSize > 0; ++i)
+  {
+    NextWorkerEvent(fPool[fNextSlot]);
+    fNextSlot = (fNextSlot + 1) % fPoolSize;
+  }
+
   for(event = 0; event < numberOfEvents; ++event)
   {
-    while(!fPythia->next());
+    if(fPoolSize == 0)
+    {
+      while(!fPythia->next());
+      FillPileUpEvent(fPythia, fEvent);
+    }
+
+    const TPileUpEvent &pileUpEvent = fPoolSize > 0 ? fPool[gRandom->Integer(fPoolSize)] : fEvent;
 
    // --- Pile-up vertex smearing
 
-    fFunction->GetRandom2(dz, dt);
+    fFunction->GetTabulatedRandom2(dz, dt);
 
     dt *= c_light*1.0E3; // necessary in order to make t in mm/c
     dz *= 1.0E3; // necessary in order to make z in mm
@@ -190,37 +388,28 @@ void PileUpMergerPythia8::Process()
 
     vx = 0.0;
     vy = 0.0;
-    numberOfParticles = fPythia->event.size();
-    for(i = 1; i < numberOfParticles; ++i)
+    numberOfParticles = pileUpEvent.size;
+    for(itParticle = pileUpEvent.particles.begin(); itParticle != pileUpEvent.particles.end(); ++itParticle)
     {
-      Pythia8::Particle &particle = fPythia->event[i];
-
-      status = particle.statusHepMC();
-
-      if(status != 1 || !particle.isVisible() || particle.pT() <= fPTMin) continue;
-
-      pid = particle.id();
-      px = particle.px(); py = particle.py(); pz = particle.pz(); e = particle.e();
-      x = particle.xProd(); y = particle.yProd(); z = particle.zProd(); t = particle.tProd();
+      const TPileUpParticle &particle = *itParticle;
 
       candidate = factory->NewCandidate();
 
-      candidate->PID = pid;
+      candidate->PID = particle.pid;
 
       candidate->Status = 1;
 
-      pdgParticle = pdg->GetParticle(pid);
-      candidate->Charge = pdgParticle ? Int_t(pdgParticle->Charge()/3.0) : -999;
-      candidate->Mass = pdgParticle ? pdgParticle->Mass() : -999.9;
+      candidate->Charge = pdg.GetCharge(particle.pid);
+      candidate->Mass = pdg.GetMass(particle.pid);
 
       candidate->IsPU = 1;
 
-      candidate->Momentum.SetPxPyPzE(px, py, pz, e);
+      candidate->Momentum.SetPxPyPzE(particle.px, particle.py, particle.pz, particle.e);
       candidate->Momentum.RotateZ(dphi);
 
-      x -= fInputBeamSpotX;
-      y -= fInputBeamSpotY;
-      candidate->Position.SetXYZT(x, y, z + dz, t + dt);
+      x = particle.x - fInputBeamSpotX;
+      y = particle.y - fInputBeamSpotY;
+      candidate->Position.SetXYZT(x, y, particle.z + dz, particle.t + dt);
       candidate->Position.RotateZ(dphi);
       candidate->Position += TLorentzVector(fOutputBeamSpotX, fOutputBeamSpotY, 0.0, 0.0);
 
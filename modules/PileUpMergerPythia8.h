@@ -29,6 +29,16 @@
 
 #include "classes/DelphesModule.h"
 
+#include <deque>
+#include <vector>
+#include <string>
+
+#if !defined(__CINT__) && !defined(__CLING__)
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#endif
+
 class TObjArray;
 class DelphesTF2;
 
@@ -63,6 +73,52 @@ private:
 
   Double_t fPTMin;
 
+#if !defined(__CINT__) && !defined(__CLING__)
+  struct TPileUpParticle
+  {
+    Int_t pid;
+    Float_t x, y, z, t;
+    Float_t px, py, pz, e;
+  };
+
+  struct TPileUpEvent
+  {
+    // size of the Pythia event, used to average the vertex position
+    Int_t size;
+    std::vector< TPileUpParticle > particles;
+  };
+
+  // keeps the visible final state particles of the current Pythia event
+  void FillPileUpEvent(Pythia8::Pythia *pythia, TPileUpEvent &event);
+
+  void WorkerLoop(Int_t worker);
+  void StopWorkers();
+  void NextWorkerEvent(TPileUpEvent &event);
+
+  // minimum-bias events reused with a new vertex and rotation,
+  // fPoolRefresh of them are replaced by new events at every event
+  std::vector< TPileUpEvent > fPool; //!
+  Int_t fNextSlot; //!
+
+  // background Pythia instances, each filling its own queue
+  std::vector< Pythia8::Pythia * > fWorkerPythia; //!
+  std::vector< std::thread > fWorkerThreads; //!
+  std::vector< std::deque< TPileUpEvent > > fWorkerQueues; //!
+  std::mutex fWorkerMutex; //!
+  std::condition_variable fWorkerNotFull; //!
+  std::condition_variable fWorkerNotEmpty; //!
+  std::string fWorkerError; //!
+  bool fStopWorkers; //!
+  Int_t fNextWorker; //!
+
+  TPileUpEvent fEvent; //!
+#endif
+
+  Int_t fPoolSize;
+  Int_t fPoolRefresh;
+  Int_t fPoolThreads;
+  Int_t fQueueSize;
+
   DelphesTF2 *fFunction; //!
 
   Pythia8::Pythia *fPythia; //!
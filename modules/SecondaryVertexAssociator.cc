@@ -28,6 +28,8 @@
 #include "modules/SecondaryVertexAssociator.h"
 
 #include "classes/DelphesClasses.h"
+#include "classes/DelphesFactory.h"
+#include "classes/DelphesPDGTable.h"
 
 #include "TLorentzVector.h"
 
@@ -103,7 +105,7 @@ void SecondaryVertexAssociator::Process(){
       }
     }
     for (const auto& vx: track_count) {
-      jet->truthVertices.push_back(vx.first);
+      jet->Vertexing().truthVertices.push_back(vx.first);
     }
   }
 }
@@ -130,7 +132,7 @@ SecondaryVertexAssociator::walkTruthRecord(Candidate* genPart,
   // check mother particles
   for (int mid: {genPart->M1, genPart->M2}) {
     if (mid == -1) continue;
-    Candidate* mother = static_cast<Candidate*>(fParticleInputArray->At(mid));
+    Candidate* mother = getGenPart(mid);
     int heaviest = get_heaviest_particle(mother->PID);
     // if this is a (stable) target particle, record vertex...
     if (targets.count(heaviest) && is_metastable(mother->PID)) {
@@ -175,7 +177,7 @@ std::vector<Candidate*> SecondaryVertexAssociator::getStableChildren(Candidate*
   return children;
 }
 Candidate* SecondaryVertexAssociator::getGenPart(int idx) {
-  return static_cast<Candidate*>(fParticleInputArray->At(idx));
+  return GetFactory()->GetGenParticle(fParticleInputArray, idx);
 }
 
 
@@ -240,8 +242,13 @@ namespace {
     return std::copysign(frac_abs / 3, pid);
   }
   int get_charge(int pid) {
-    // this is only supposed to work with (meta)stable particles,
-    // mesons, baryons, and leptons
+    // take the charge from the particle table when it knows the code
+    const DelphesPDGTable::Entry* entry =
+      DelphesPDGTable::Instance().GetEntry(pid);
+    if (entry) return entry->Charge;
+
+    // otherwise, this is only supposed to work with (meta)stable
+    // particles, mesons, baryons, and leptons
     int aid = std::abs(pid);
     if (aid > 10 && aid < 20) return lept_charge(pid);
     if (aid > 100 && aid < 1000000) return had_charge(pid);
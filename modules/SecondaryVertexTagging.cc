@@ -333,6 +333,9 @@ SortedTracks SecondaryVertexTagging::SelectTracksInJet(
 
 void SecondaryVertexTagging::Process()
 {
+  // each track is converted to Rave once per event
+  fRaveConverter->clearCache();
+
   fItJetInputArray->Reset();
   Candidate* jet;
   const auto& primary = GetPrimaryVertex();
@@ -350,9 +353,10 @@ void SecondaryVertexTagging::Process()
   while((jet = static_cast<Candidate*>(fItJetInputArray->Next())))
   {
     const TLorentzVector& jvec = jet->Momentum;
+    CandidateVertexing& vertexing = jet->Vertexing();
 
     auto all_tracks = SelectTracksInJet(jet, primary_weight);
-    jet->primaryVertexTracks = get_tracks_along_jet(
+    vertexing.primaryVertexTracks = get_tracks_along_jet(
       all_tracks.first, jvec.Vect(), fPrimaryVertexCompatibility);
     auto jet_tracks = fRaveConverter->getRaveTracks(all_tracks.second);
     double jet_track_energy = track_energy(all_tracks.all);
@@ -387,7 +391,7 @@ void SecondaryVertexTagging::Process()
           auto out_vert = sv_from_rave_sv(
             vert, jet_track_energy, jvec.Vect());
           out_vert.config = "med-level";
-          jet->secondaryVertices.push_back(out_vert);
+          vertexing.secondaryVertices.push_back(out_vert);
         }
       } catch (cms::Exception& e) {
         fDebugCounts[oneline(e.what())]++;
@@ -395,16 +399,16 @@ void SecondaryVertexTagging::Process()
     }   // end check for two tracks
     // high level (one fitted vertex)
     assert(hl_svx.size() <= 1);
-    jet->hlSecVxTracks.clear();
+    vertexing.hlSecVxTracks.clear();
     if (hl_svx.size() > 0) {
-      jet->hlSecVxTracks = hl_svx.at(0).tracks_along_jet;
+      vertexing.hlSecVxTracks = hl_svx.at(0).tracks_along_jet;
     }
-    jet->hlSvx.fill(jvec.Vect(), hl_svx, 0);
-    jet->primaryVertex = sv_from_rave_pv(
+    vertexing.hlSvx.fill(jvec.Vect(), hl_svx, 0);
+    vertexing.primaryVertex = sv_from_rave_pv(
       second(all_tracks.first),
       jet_track_energy);
     // medium level (multiple vertices)
-    jet->mlSvx.fill(jvec.Vect(), jet->secondaryVertices, 0);
+    vertexing.mlSvx.fill(jvec.Vect(), vertexing.secondaryVertices, 0);
   }   // end jet loop
 }
 
@@ -641,7 +645,8 @@ namespace {
     for (const auto& wt_trk: delphes_tracks) {
       if (wt_trk.first < threshold) continue;
       const auto& trk = wt_trk.second;
-      TrackParameters params(trk->trkPar, trk->trkCov);
+      const auto& trk_pars = trk->GetTrackParameters();
+      TrackParameters params(trk_pars.trkPar, trk_pars.trkCov);
       SecondaryVertexTrack track;
       track.weight = wt_trk.first;
       track.d0 = params.d0;
@@ -702,13 +707,14 @@ namespace {
 	      << std::endl;
   }
   void print_more_info(const Candidate* cand) {
+    const float* trkPar = cand->GetTrackParameters().trkPar;
     float d0 = cand->Dxy;
-    assert(d0 == cand->trkPar[TrackParam::D0]);
-    float z = cand->trkPar[TrackParam::Z0];
+    assert(d0 == trkPar[TrackParam::D0]);
+    float z = trkPar[TrackParam::Z0];
     std::cout << "d0: " << d0*0.1 << ", z: " << z*0.1
-							<< ", qop: " << cand->trkPar[TrackParam::QOVERP]*10
-							<< ", theta: " << cand->trkPar[TrackParam::THETA]
-							<< ", phi: " << cand->trkPar[TrackParam::PHI] << std::endl;
+							<< ", qop: " << trkPar[TrackParam::QOVERP]*10
+							<< ", theta: " << trkPar[TrackParam::THETA]
+							<< ", phi: " << trkPar[TrackParam::PHI] << std::endl;
     auto& mom = cand->Momentum;
     std::cout << "(" << cand->Xd*0.1 << ", " << cand->Yd*0.1 << ", "
 							<< z*0.1 << " , " << mom.X() << ", " << mom.Y() << ", "
@@ -721,17 +727,18 @@ namespace {
     const Candidate* mother = get_part(cand);
     const TLorentzVector& mpos = mother->Position;
 
+    const float* trkPar = cand->GetTrackParameters().trkPar;
     float d0 = cand->Dxy;
-    assert(d0 == cand->trkPar[TrackParam::D0]);
-    float phi = cand->trkPar[TrackParam::PHI];
-    float z = cand->trkPar[TrackParam::Z0];
+    assert(d0 == trkPar[TrackParam::D0]);
+    float phi = trkPar[TrackParam::PHI];
+    float z = trkPar[TrackParam::Z0];
     float phi0 = phi - std::copysign(3.14159/2, 1);
     float x = d0 * std::cos(phi0);
     float y = d0 * std::sin(phi0);
     std::cout << "d0: " << d0 << ", z: " << z
-							<< ", qop: " << cand->trkPar[TrackParam::QOVERP]
-							<< ", theta: " << cand->trkPar[TrackParam::THETA]
-							<< ", phi: " << cand->trkPar[TrackParam::PHI] << std::endl;
+							<< ", qop: " << trkPar[TrackParam::QOVERP]
+							<< ", theta: " << trkPar[TrackParam::THETA]
+							<< ", phi: " << trkPar[TrackParam::PHI] << std::endl;
     std::cout << "dphi: " << (phi0 - std::atan2(cand->Yd, cand->Xd))/3.1415
 							<< "pi " << std::endl;
     std::cout << "initial x, y, z, r: " << mpos.X() << " " << mpos.Y() << " "
@@ -787,7 +794,7 @@ void SecondaryVertexTagging::Process() {
     SecondaryVertex test;
     test.Lxy = -1;
     test.config = "zork";
-    jet->secondaryVertices.push_back(test);
+    jet->Vertexing().secondaryVertices.push_back(test);
   }
 }
 void SecondaryVertexTagging::Finish() {}
@@ -82,7 +82,7 @@ void TaggingParticlesSkimmer::Init()
   fParticleInputArray = ImportArray(GetString("ParticleInputArray", "Delphes/allParticles"));
 
  
-  fClassifier = new TauTaggingPartonClassifier(fParticleInputArray);
+  fClassifier = new TauTaggingPartonClassifier(fParticleInputArray, GetFactory());
   fClassifier->fPTMin = GetDouble("PTMin", 15.0);
   fClassifier->fEtaMax = GetDouble("EtaMax", 2.5);
 
@@ -126,8 +126,8 @@ void TaggingParticlesSkimmer::Process()
   {
     if(tau->D1 < 0) continue;
 
-    if(tau->D1 >= fParticleInputArray->GetEntriesFast() ||
-       tau->D2 >= fParticleInputArray->GetEntriesFast())
+    if(tau->D1 >= GetFactory()->GetGenParticleCount(fParticleInputArray) ||
+       tau->D2 >= GetFactory()->GetGenParticleCount(fParticleInputArray))
     {
       throw runtime_error("tau's daughter index is greater than the ParticleInputArray size");
     }
@@ -136,7 +136,7 @@ void TaggingParticlesSkimmer::Process()
     
     for(i = tau->D1; i <= tau->D2; ++i)
     {
-      daughter = static_cast<Candidate *>(fParticleInputArray->At(i));
+      daughter = GetFactory()->GetGenParticle(fParticleInputArray, i);
       if(TMath::Abs(daughter->PID) == 16) continue;
       tauMomentum += daughter->Momentum;
     }
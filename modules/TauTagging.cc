@@ -50,8 +50,8 @@ using namespace std;
 
 
 //------------------------------------------------------------------------------
-TauTaggingPartonClassifier::TauTaggingPartonClassifier(const TObjArray *array) :
-  fParticleInputArray(array)
+TauTaggingPartonClassifier::TauTaggingPartonClassifier(const TObjArray *array, DelphesFactory *factory) :
+  fParticleInputArray(array), fFactory(factory)
 {
 }
 
@@ -75,15 +75,15 @@ Int_t TauTaggingPartonClassifier::GetCategory(TObject *object)
 
   if(tau->D2 < tau->D1) return -1;
 
-  if(tau->D1 >= fParticleInputArray->GetEntriesFast() ||
-     tau->D2 >= fParticleInputArray->GetEntriesFast())
+  if(tau->D1 >= fFactory->GetGenParticleCount(fParticleInputArray) ||
+     tau->D2 >= fFactory->GetGenParticleCount(fParticleInputArray))
   {
     throw runtime_error("tau's daughter index is greater than the ParticleInputArray size");
   }
 
   for(i = tau->D1; i <= tau->D2; ++i)
   {
-    daughter1 = static_cast<Candidate *>(fParticleInputArray->At(i));
+    daughter1 = fFactory->GetGenParticle(fParticleInputArray, i);
     pdgCode = TMath::Abs(daughter1->PID);
     if(pdgCode == 11 || pdgCode == 13 || pdgCode == 15) return -1;
     else if(pdgCode == 24)
@@ -91,7 +91,7 @@ Int_t TauTaggingPartonClassifier::GetCategory(TObject *object)
      if(daughter1->D1 < 0) return -1;
      for(j = daughter1->D1; j <= daughter1->D2; ++j)
      {
-       daughter2 = static_cast<Candidate*>(fParticleInputArray->At(j));
+       daughter2 = fFactory->GetGenParticle(fParticleInputArray, j);
        pdgCode = TMath::Abs(daughter2->PID);
        if(pdgCode == 11 || pdgCode == 13) return -1;
      }
@@ -154,7 +154,7 @@ void TauTagging::Init()
 
   fParticleInputArray = ImportArray(GetString("ParticleInputArray", "Delphes/allParticles"));
 
-  fClassifier = new TauTaggingPartonClassifier(fParticleInputArray);
+  fClassifier = new TauTaggingPartonClassifier(fParticleInputArray, GetFactory());
   fClassifier->fPTMin = GetDouble("TauPTMin", 1.0);
   fClassifier->fEtaMax = GetDouble("TauEtaMax", 2.5);
 
@@ -220,8 +220,8 @@ void TauTagging::Process()
       {
         if(tau->D1 < 0) continue;
 
-        if(tau->D1 >= fParticleInputArray->GetEntriesFast() ||
-           tau->D2 >= fParticleInputArray->GetEntriesFast())
+        if(tau->D1 >= GetFactory()->GetGenParticleCount(fParticleInputArray) ||
+           tau->D2 >= GetFactory()->GetGenParticleCount(fParticleInputArray))
         {
           throw runtime_error("tau's daughter index is greater than the ParticleInputArray size");
         }
@@ -230,7 +230,7 @@ void TauTagging::Process()
 
         for(i = tau->D1; i <= tau->D2; ++i)
         {
-          daughter = static_cast<Candidate *>(fParticleInputArray->At(i));
+          daughter = GetFactory()->GetGenParticle(fParticleInputArray, i);
           if(TMath::Abs(daughter->PID) == 16) continue;
           tauMomentum += daughter->Momentum;
         }
@@ -85,13 +85,15 @@ class TauTaggingPartonClassifier : public ExRootClassifier
 {
 public:
 
-  TauTaggingPartonClassifier(const TObjArray *array);
+  TauTaggingPartonClassifier(const TObjArray *array, DelphesFactory *factory);
 
   Int_t GetCategory(TObject *object);
 
   Double_t fEtaMax, fPTMin;
 
   const TObjArray *fParticleInputArray;
+
+  DelphesFactory *fFactory;
 };
 
 
@@ -38,6 +38,7 @@
 #include "TRandom3.h"
 #include "TObjArray.h"
 #include "TLorentzVector.h"
+#include "TVector2.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -88,38 +89,59 @@ void TrackBasedBTagging::Finish()
 
 void TrackBasedBTagging::Process()
 {
+  Candidate *jet, *track;
+  Double_t jetEta, jetPhi, deta, dphi;
+  size_t i;
+
+  // select the tracks once for all jets
+  fTracks.clear();
+  fTrackEta.clear();
+  fTrackPhi.clear();
+  fItTrackInputArray->Reset();
+  while((track = static_cast<Candidate*>(fItTrackInputArray->Next())))
+  {
+    const TLorentzVector &trkMomentum = track->Momentum;
+
+    if(trkMomentum.Pt() < fPtMin) continue;
+    if(std::abs(track->Dxy) > fIPmax) continue;
+
+    fTracks.push_back(track);
+    fTrackEta.push_back(trkMomentum.Eta());
+    fTrackPhi.push_back(trkMomentum.Phi());
+  }
+
+  std::vector<TrackParameters> trk_pars;
 
   // loop over all input jets
   fItJetInputArray->Reset();
-  Candidate* jet;
   while((jet = static_cast<Candidate*>(fItJetInputArray->Next())))
   {
     const TLorentzVector &jetMomentum = jet->Momentum;
 
-    std::vector<TrackParameters> trk_pars;
+    trk_pars.clear();
     if (jet->GetTracks()->GetEntriesFast() > 0) {
       throw std::logic_error("tried to add traks to a jet twice");
     }
-    // loop over all input tracks
-    fItTrackInputArray->Reset();
-    Candidate* track;
-    while((track = static_cast<Candidate*>(fItTrackInputArray->Next())))
-    {
-      const TLorentzVector &trkMomentum = track->Momentum;
 
-      double dr = jetMomentum.DeltaR(trkMomentum);
-      double tpt = trkMomentum.Pt();
-      double dxy = std::abs(track->Dxy);
+    jetEta = jetMomentum.Eta();
+    jetPhi = jetMomentum.Phi();
 
-      if(tpt < fPtMin) continue;
-      if(dr > fDeltaR) continue;
-      if(dxy > fIPmax) continue;
-      trk_pars.emplace_back(track->trkPar, track->trkCov);
+    // loop over the selected tracks
+    for(i = 0; i < fTracks.size(); ++i)
+    {
+      // same as TLorentzVector::DeltaR
+      deta = jetEta - fTrackEta[i];
+      dphi = TVector2::Phi_mpi_pi(jetPhi - fTrackPhi[i]);
+      if(TMath::Sqrt(deta*deta + dphi*dphi) > fDeltaR) continue;
+
+      track = fTracks[i];
+      const CandidateTrackParameters& trackParameters = track->GetTrackParameters();
+      trk_pars.emplace_back(trackParameters.trkPar, trackParameters.trkCov);
       // std::cout << trk_pars.back() << std::endl;
       jet->AddTrack(track);
     }
-    jet->hlTrk.fill(jetMomentum.Vect(), trk_pars);
-    // std::cout << jet->hlTrk << std::endl;
+    jet->Vertexing().hlTrk.fill(jetMomentum.Vect(), trk_pars);
+    // std::cout << jet->GetVertexing().hlTrk << std::endl;
 
   }
 }
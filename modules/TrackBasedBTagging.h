@@ -30,8 +30,10 @@
 #include "classes/DelphesModule.h"
 
 #include <map>
+#include <vector>
 
 class TObjArray;
+class Candidate;
 
 class TrackBasedBTagging: public DelphesModule
 {
@@ -50,6 +52,14 @@ private:
   Double_t fDeltaR;
   Double_t fIPmax;
 
+#if !defined(__CINT__) && !defined(__CLING__)
+  // tracks passing the pT and impact parameter cuts, with the
+  // pseudorapidity and azimuth used to match them to every jet
+  std::vector< Candidate * > fTracks; //!
+  std::vector< Double_t > fTrackEta; //!
+  std::vector< Double_t > fTrackPhi; //!
+#endif
+
   TIterator *fItTrackInputArray; //!
   TIterator *fItJetInputArray; //!
 
@@ -96,6 +96,9 @@ void TreeWriter::Init()
   TObjArray *array;
   ExRootTreeBranch *branch;
 
+  // copies made by a parameter scan only write the varied arrays
+  TString scanSuffix = GetString("ScanSuffix", "");
+
   size = param.GetSize();
   for(i = 0; i < size/3; ++i)
   {
@@ -103,6 +106,12 @@ void TreeWriter::Init()
     branchName = param[i*3 + 1].GetString();
     branchClassName = param[i*3 + 2].GetString();
 
+    if(scanSuffix.Length() > 0)
+    {
+      if(!branchInputArray.Contains(scanSuffix + "/")) continue;
+      branchName += scanSuffix;
+    }
+
     branchClass = gROOT->GetClass(branchClassName);
 
     if(!branchClass)
@@ -316,10 +325,11 @@ void TreeWriter::ProcessTracks(ExRootTreeBranch *branch, TObjArray *array)
     entry->Zd = candidate->Zd;
 
     //track parameters
+    const CandidateTrackParameters &trackParameters = candidate->GetTrackParameters();
     for(int i=0;i<5;i++)
-     entry->trkPar[i] = candidate->trkPar[i];
+     entry->trkPar[i] = trackParameters.trkPar[i];
     for(int i=0;i<15;i++)
-     entry->trkCov[i] = candidate->trkCov[i];
+     entry->trkCov[i] = trackParameters.trkCov[i];
     assert(check_d0_z0(entry));
 
     const TLorentzVector &momentum = candidate->Momentum;
@@ -394,6 +404,37 @@ void TreeWriter::ProcessTowers(ExRootTreeBranch *branch, TObjArray *array)
 
 //------------------------------------------------------------------------------
 
+void TreeWriter::SortByPT(TObjArray *array)
+{
+  Int_t i, size;
+  TObject **objects;
+
+  // same order as TObjArray::Sort with CompMomentumPt, but the transverse
+  // momentum is computed once per candidate and not at every comparison
+
+  size = array->GetEntriesFast();
+  if(size < 2) return;
+
+  objects = array->GetObjectRef();
+
+  fSortKeys.resize(size);
+  fSortObjects.assign(objects, objects + size);
+
+  for(i = 0; i < size; ++i)
+  {
+    fSortKeys[i] = make_pair(-static_cast<Candidate *>(objects[i])->Momentum.Pt(), i);
+  }
+
+  sort(fSortKeys.begin(), fSortKeys.end());
+
+  for(i = 0; i < size; ++i)
+  {
+    objects[i] = fSortObjects[fSortKeys[i].second];
+  }
+}
+
+//------------------------------------------------------------------------------
+
 void TreeWriter::ProcessPhotons(ExRootTreeBranch *branch, TObjArray *array)
 {
   TIter iterator(array);
@@ -402,7 +443,7 @@ void TreeWriter::ProcessPhotons(ExRootTreeBranch *branch, TObjArray *array)
   Double_t pt, signPz, cosTheta, eta, rapidity;
   const Double_t c_light = 2.99792458E8;
 
-  array->Sort();
+  SortByPT(array);
 
   // loop over all photons
   iterator.Reset();
@@ -453,7 +494,7 @@ void TreeWriter::ProcessElectrons(ExRootTreeBranch *branch, TObjArray *array)
   Double_t pt, signPz, cosTheta, eta, rapidity;
   const Double_t c_light = 2.99792458E8;
 
-  array->Sort();
+  SortByPT(array);
 
   // loop over all electrons
   iterator.Reset();
@@ -505,7 +546,7 @@ void TreeWriter::ProcessMuons(ExRootTreeBranch *branch, TObjArray *array)
 
   const Double_t c_light = 2.99792458E8;
 
-  array->Sort();
+  SortByPT(array);
 
   // loop over all muons
   iterator.Reset();
@@ -570,7 +611,7 @@ void TreeWriter::ProcessJets(ExRootTreeBranch *branch, TObjArray *array)
   const Double_t c_light = 2.99792458E8;
   Int_t i;
 
-  array->Sort();
+  SortByPT(array);
 
   // loop over all jets
   iterator.Reset();
@@ -611,15 +652,17 @@ void TreeWriter::ProcessJets(ExRootTreeBranch *branch, TObjArray *array)
     entry->BTagAlgo = candidate->BTagAlgo;
     entry->BTagPhys = candidate->BTagPhys;
 
+    const CandidateVertexing& vertexing = candidate->GetVertexing();
+
     entry->PrimaryVertexTracks.clear();
-    for (const auto& vxtrk: candidate->primaryVertexTracks) {
+    for (const auto& vxtrk: vertexing.primaryVertexTracks) {
       TSecondaryVertexTrack track;
       copy(vxtrk, track);
       entry->PrimaryVertexTracks.push_back(track);
     }
 
     entry->SecondaryVertices.clear();
-    for (const auto& vx: candidate->secondaryVertices) {
+    for (const auto& vx: vertexing.secondaryVertices) {
       TSecondaryVertex tvx;
       tvx.x = vx.X();
       tvx.y = vx.Y();
@@ -642,16 +685,16 @@ void TreeWriter::ProcessJets(ExRootTreeBranch *branch, TObjArray *array)
       entry->SecondaryVertices.push_back(tvx);
     }
     entry->HLSecondaryVertexTracks.clear();
-    for (const auto& vxtrk: candidate->hlSecVxTracks) {
+    for (const auto& vxtrk: vertexing.hlSecVxTracks) {
       TSecondaryVertexTrack track;
       copy(vxtrk, track);
       entry->HLSecondaryVertexTracks.push_back(track);
     }
-    copy(candidate->hlSvx, entry->HLSecondaryVertex);
-    copy(candidate->mlSvx, entry->MLSecondaryVertex);
-    copy(candidate->hlTrk, *entry);
+    copy(vertexing.hlSvx, entry->HLSecondaryVertex);
+    copy(vertexing.mlSvx, entry->MLSecondaryVertex);
+    copy(vertexing.hlTrk, *entry);
     entry->TruthVertices.clear();
-    for (const auto& vx: candidate->truthVertices) {
+    for (const auto& vx: vertexing.truthVertices) {
       entry->TruthVertices.push_back(vx);
     }
 
@@ -700,17 +743,19 @@ void TreeWriter::ProcessJets(ExRootTreeBranch *branch, TObjArray *array)
 
     //--- Sub-structure variables ----
 
-    entry->NSubJetsTrimmed = candidate->NSubJetsTrimmed;
-    entry->NSubJetsPruned = candidate->NSubJetsPruned;
-    entry->NSubJetsSoftDropped = candidate->NSubJetsSoftDropped;
+    const CandidateSubstructure &substructure = candidate->GetSubstructure();
+
+    entry->NSubJetsTrimmed = substructure.NSubJetsTrimmed;
+    entry->NSubJetsPruned = substructure.NSubJetsPruned;
+    entry->NSubJetsSoftDropped = substructure.NSubJetsSoftDropped;
 
     for(i = 0; i < 5; i++)
     {
       entry->FracPt[i] = candidate -> FracPt[i];
-      entry->Tau[i] = candidate -> Tau[i];
-      entry->TrimmedP4[i] = candidate -> TrimmedP4[i];
-      entry->PrunedP4[i] = candidate -> PrunedP4[i];
-      entry->SoftDroppedP4[i] = candidate -> SoftDroppedP4[i];
+      entry->Tau[i] = substructure.Tau[i];
+      entry->TrimmedP4[i] = substructure.TrimmedP4[i];
+      entry->PrunedP4[i] = substructure.PrunedP4[i];
+      entry->SoftDroppedP4[i] = substructure.SoftDroppedP4[i];
     }
 
     FillParticles(candidate, &entry->Particles);
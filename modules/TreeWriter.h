@@ -30,6 +30,8 @@
 #include "classes/DelphesModule.h"
 
 #include <map>
+#include <vector>
+#include <utility>
 
 class TClass;
 class TObjArray;
@@ -53,6 +55,8 @@ private:
 
   void FillParticles(Candidate *candidate, TRefArray *array);
 
+  void SortByPT(TObjArray *array);
+
   void ProcessParticles(ExRootTreeBranch *branch, TObjArray *array);
   void ProcessVertices(ExRootTreeBranch *branch, TObjArray *array);
   void ProcessTracks(ExRootTreeBranch *branch, TObjArray *array);
@@ -76,6 +80,9 @@ private:
   TBranchMap fBranchMap; //!
 
   std::map< TClass *, TProcessMethod > fClassMap; //!
+
+  std::vector< std::pair< Double_t, Int_t > > fSortKeys; //!
+  std::vector< TObject * > fSortObjects; //!
 #endif
 
   ClassDef(TreeWriter, 1)
@@ -0,0 +1,936 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ *  Runs a detector card on events from a synthetic generator and measures
+ *  the throughput of the whole chain and of every module. The generator
+ *  produces a number of jets with a given heavy-flavour fraction, soft
+ *  particles from the underlying event and from pile-up interactions.
+ *  The results are written in JSON, so that they can be compared between
+ *  versions and machines. With a list of multiplicities, the same card is
+ *  timed at every multiplicity and the time of each module is fitted with
+ *  a power of the number of particles, to see how the modules scale.
+ *  With a list of track multiplicities, the per-jet kernels of the flavour
+ *  tagging output (HighLevelTracking::fill and the HDF5 track buffer) are
+ *  also timed directly on jets with that many tracks.
+ */
+
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <utility>
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "TROOT.h"
+#include "TApplication.h"
+#include "TSystem.h"
+
+#include "TFile.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TObjArray.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TVector2.h"
+#include "TVector3.h"
+
+#include "modules/Delphes.h"
+#include "classes/DelphesClasses.h"
+#include "classes/DelphesFactory.h"
+#include "classes/DelphesReader.h"
+#include "classes/DelphesPDGTable.h"
+#include "classes/DelphesEventRecord.h"
+#include "classes/DelphesEventPipeline.h"
+#include "classes/flavortag/hl_vars.hh"
+#include "classes/flavortag/enums_track.hh"
+
+#include "modules/HDF5Writer.h"
+
+#include "ExRootAnalysis/ExRootTask.h"
+#include "ExRootAnalysis/ExRootTreeWriter.h"
+#include "ExRootAnalysis/ExRootTreeBranch.h"
+#include "ExRootAnalysis/ExRootProgressBar.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+static bool interrupted = false;
+
+void SignalHandler(int sig)
+{
+  interrupted = true;
+}
+
+//---------------------------------------------------------------------------
+
+struct BenchSettings
+{
+  Long64_t events, warmup;
+  // mean number of soft particles per interaction, one timing point per value
+  vector< Double_t > multiplicities;
+  Double_t pileUp;
+  Int_t jets;
+  Double_t heavyFlavour;
+  Double_t jetPTMin, jetPTSlope;
+  Int_t seed;
+  // numbers of tracks per jet of the kernel sweep
+  vector< Double_t > tracks;
+};
+
+//---------------------------------------------------------------------------
+
+struct BenchPoint
+{
+  Double_t multiplicity;
+  Long64_t events, particles;
+  Double_t genTime, procTime, procCpuTime, fillTime;
+  vector< Double_t > moduleTime, moduleCpuTime;
+};
+
+//---------------------------------------------------------------------------
+
+struct KernelPoint
+{
+  Int_t tracks;
+  Long64_t jets;
+  Double_t fillTime, bufferTime;
+};
+
+//---------------------------------------------------------------------------
+
+class SyntheticGenerator: public DelphesReader
+{
+public:
+
+  SyntheticGenerator(const BenchSettings &settings) :
+    fSettings(settings), fRandom(settings.seed), fCounter(0),
+    fPDG(&DelphesPDGTable::Instance())
+  {
+  }
+
+  void SetInputFile(FILE *inputFile) {}
+
+  void Clear() {}
+
+  bool ReadEvent(DelphesEventRecord &record);
+
+private:
+
+  void AddParticle(DelphesEventRecord &record, Int_t pid, Int_t status,
+    Double_t pt, Double_t eta, Double_t phi,
+    Double_t x, Double_t y, Double_t z);
+
+  void AddSoftParticles(DelphesEventRecord &record, Int_t count, Double_t z);
+
+  void AddJet(DelphesEventRecord &record, Double_t z);
+
+  Int_t GetHadron(Bool_t soft);
+
+  BenchSettings fSettings;
+  TRandom3 fRandom;
+  Long64_t fCounter;
+  const DelphesPDGTable *fPDG;
+};
+
+//---------------------------------------------------------------------------
+
+bool SyntheticGenerator::ReadEvent(DelphesEventRecord &record)
+{
+  Int_t i, interactions;
+  Double_t z, multiplicity;
+  Long64_t blockSize, point;
+
+  // the points are processed one after the other, each with its warm-up events
+  blockSize = fSettings.events + fSettings.warmup;
+  point = fCounter/blockSize;
+  if(point >= Long64_t(fSettings.multiplicities.size())) return false;
+  multiplicity = fSettings.multiplicities[point];
+
+  record.Clear();
+  record.Number = ++fCounter;
+
+  // hard interaction: jets and underlying event
+  z = fRandom.Gaus(0.0, 50.0);
+  for(i = 0; i < fSettings.jets; ++i)
+  {
+    AddJet(record, z);
+  }
+  AddSoftParticles(record, fRandom.Poisson(multiplicity), z);
+
+  // pile-up interactions along the beam spot
+  interactions = fRandom.Poisson(fSettings.pileUp);
+  for(i = 0; i < interactions; ++i)
+  {
+    AddSoftParticles(record, fRandom.Poisson(multiplicity), fRandom.Gaus(0.0, 50.0));
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+void SyntheticGenerator::AddParticle(DelphesEventRecord &record, Int_t pid, Int_t status,
+  Double_t pt, Double_t eta, Double_t phi,
+  Double_t x, Double_t y, Double_t z)
+{
+  Double_t px, py, pz, mass, e;
+
+  mass = fPDG->GetMass(pid, 0.0);
+  px = pt*TMath::Cos(phi);
+  py = pt*TMath::Sin(phi);
+  pz = pt*TMath::SinH(eta);
+  e = TMath::Sqrt(px*px + py*py + pz*pz + mass*mass);
+
+  record.AddParticle(pid, status, -1, -1, -1, -1, px, py, pz, e, mass, x, y, z, 0.0);
+}
+
+//---------------------------------------------------------------------------
+
+Int_t SyntheticGenerator::GetHadron(Bool_t soft)
+{
+  Double_t u = fRandom.Rndm();
+  Int_t sign = fRandom.Rndm() < 0.5 ? 1 : -1;
+
+  // rough composition of the final state: charged pions, photons from
+  // neutral pion decays, kaons, protons and neutrons
+  if(u < 0.55) return 211*sign;
+  if(u < 0.85) return 22;
+  if(u < 0.92) return 321*sign;
+  if(u < 0.95) return 130;
+  if(u < 0.98 || soft) return 2212*sign;
+  return 2112*sign;
+}
+
+//---------------------------------------------------------------------------
+
+void SyntheticGenerator::AddSoftParticles(DelphesEventRecord &record, Int_t count, Double_t z)
+{
+  Int_t i;
+
+  for(i = 0; i < count; ++i)
+  {
+    AddParticle(record, GetHadron(kTRUE), 1,
+      0.1 + fRandom.Exp(0.5), fRandom.Uniform(-5.0, 5.0), fRandom.Uniform(-TMath::Pi(), TMath::Pi()),
+      0.0, 0.0, z);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+void SyntheticGenerator::AddJet(DelphesEventRecord &record, Double_t z)
+{
+  vector< Double_t > fractions;
+  Double_t pt, eta, phi, sum, length, x, y, u;
+  Int_t i, count, flavour;
+
+  pt = fSettings.jetPTMin + fRandom.Exp(fSettings.jetPTSlope);
+  eta = fRandom.Uniform(-2.5, 2.5);
+  phi = fRandom.Uniform(-TMath::Pi(), TMath::Pi());
+
+  u = fRandom.Rndm();
+  if(u < 0.5*fSettings.heavyFlavour) flavour = 5;
+  else if(u < fSettings.heavyFlavour) flavour = 4;
+  else if(fRandom.Rndm() < 0.5) flavour = 21;
+  else flavour = 1 + fRandom.Integer(3);
+
+  if(flavour != 21 && fRandom.Rndm() < 0.5) flavour = -flavour;
+
+  AddParticle(record, flavour, 23, pt, eta, phi, 0.0, 0.0, z);
+
+  // heavy-flavour jets come from a displaced vertex
+  x = 0.0;
+  y = 0.0;
+  if(TMath::Abs(flavour) == 4 || TMath::Abs(flavour) == 5)
+  {
+    length = fRandom.Exp(TMath::Abs(flavour) == 5 ? 0.45 : 0.15)*pt*TMath::CosH(eta)/5.0;
+    x = length*TMath::Cos(phi)/TMath::CosH(eta);
+    y = length*TMath::Sin(phi)/TMath::CosH(eta);
+    z += length*TMath::TanH(eta);
+  }
+
+  // share the jet momentum between its constituents
+  count = 1 + fRandom.Poisson(5.0 + pt/10.0);
+  fractions.resize(count);
+  sum = 0.0;
+  for(i = 0; i < count; ++i)
+  {
+    fractions[i] = fRandom.Exp(1.0);
+    sum += fractions[i];
+  }
+
+  for(i = 0; i < count; ++i)
+  {
+    AddParticle(record, GetHadron(kFALSE), 1,
+      pt*fractions[i]/sum, eta + fRandom.Gaus(0.0, 0.1), phi + fRandom.Gaus(0.0, 0.1),
+      x, y, z);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// reads a comma separated list of numbers
+void ParseList(vector< Double_t > &list, const string &text)
+{
+  stringstream stream(text);
+  string item;
+
+  list.clear();
+  while(getline(stream, item, ','))
+  {
+    if(!item.empty()) list.push_back(atof(item.c_str()));
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// exponent of a power law fitted to (x, y) in log-log scale
+Double_t GetScaling(const vector< pair< Double_t, Double_t > > &points)
+{
+  Double_t x, y, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0, n = 0.0;
+  size_t i;
+
+  for(i = 0; i < points.size(); ++i)
+  {
+    if(points[i].first <= 0.0 || points[i].second <= 0.0) continue;
+    x = TMath::Log(points[i].first);
+    y = TMath::Log(points[i].second);
+    sx += x;
+    sy += y;
+    sxx += x*x;
+    sxy += x*y;
+    n += 1.0;
+  }
+
+  if(n < 2.0 || n*sxx - sx*sx <= 0.0) return 0.0;
+
+  return (n*sxy - sx*sy)/(n*sxx - sx*sx);
+}
+
+//---------------------------------------------------------------------------
+
+// times HighLevelTracking::fill and the push_back and flush of the
+// primary-vertex tracks of one jet in the HDF5 track buffer (in memory,
+// with the buffer size of HDF5Writer) for every number of tracks
+void TimeKernels(const BenchSettings &settings, vector< KernelPoint > &points)
+{
+  const Int_t kJets = 100;
+  TRandom3 random(settings.seed);
+  TStopwatch stopWatch;
+  vector< TVector3 > jets(kJets);
+  vector< vector< TrackParameters > > tracks(kJets);
+  vector< vector< out::VertexTrack > > rows(kJets);
+  HighLevelTracking tracking;
+  out::VertexTrack row;
+  Float_t par[5], cov[15];
+  Double_t pt, eta, phi, d0Error, z0Error;
+  Long64_t event;
+  Int_t i, jet, track, count;
+  size_t point;
+
+  H5::FileAccPropList access;
+  access.setCore(1 << 24, false);
+  H5::H5File file("DelphesBench_kernels.h5", H5F_ACC_TRUNC, H5::FileCreatPropList::DEFAULT, access);
+
+  points.resize(settings.tracks.size());
+  for(point = 0; point < points.size(); ++point)
+  {
+    KernelPoint &result = points[point];
+    count = Int_t(settings.tracks[point]);
+
+    // a set of jets reused for all the timed calls
+    for(jet = 0; jet < kJets; ++jet)
+    {
+      pt = 20.0 + random.Exp(50.0);
+      eta = random.Uniform(-2.5, 2.5);
+      phi = random.Uniform(-TMath::Pi(), TMath::Pi());
+      jets[jet].SetPtEtaPhi(pt, eta, phi);
+
+      tracks[jet].clear();
+      rows[jet].clear();
+      for(track = 0; track < count; ++track)
+      {
+        d0Error = 0.01 + random.Exp(0.02);
+        z0Error = 0.02 + random.Exp(0.04);
+        for(i = 0; i < 15; ++i) cov[i] = 0.0;
+        par[trk::D0] = random.Gaus(0.0, 0.05);
+        par[trk::Z0] = random.Gaus(0.0, 0.1);
+        par[trk::PHI] = TVector2::Phi_mpi_pi(phi + random.Gaus(0.0, 0.1));
+        par[trk::THETA] = 2.0*TMath::ATan(TMath::Exp(-eta - random.Gaus(0.0, 0.1)));
+        par[trk::QOVERP] = (random.Rndm() < 0.5 ? 1.0 : -1.0)/(0.5 + random.Exp(5.0));
+        cov[trk::D0D0] = d0Error*d0Error;
+        cov[trk::Z0Z0] = z0Error*z0Error;
+        tracks[jet].push_back(TrackParameters(par, cov));
+
+        row.d0 = par[trk::D0];
+        row.z0 = par[trk::Z0];
+        row.d0_uncertainty = d0Error;
+        row.z0_uncertainty = z0Error;
+        row.pt = TMath::Sin(par[trk::THETA])/TMath::Abs(par[trk::QOVERP]);
+        row.delta_phi_jet = par[trk::PHI] - phi;
+        row.delta_eta_jet = -TMath::Log(TMath::Tan(0.5*par[trk::THETA])) - eta;
+        row.weight = 1.0;
+        rows[jet].push_back(row);
+      }
+    }
+
+    result.tracks = count;
+    result.jets = settings.events;
+
+    // the kernels take about a microsecond per jet, so the stopwatch is
+    // started once around all the timed calls, after the warm-up calls
+    for(event = 0; event < settings.warmup; ++event)
+    {
+      jet = event % kJets;
+      tracking.fill(jets[jet], tracks[jet]);
+    }
+
+    stopWatch.Start();
+    for(event = settings.warmup; event < settings.warmup + settings.events; ++event)
+    {
+      jet = event % kJets;
+      tracking.fill(jets[jet], tracks[jet]);
+    }
+    stopWatch.Stop();
+    result.fillTime = stopWatch.RealTime();
+
+    stringstream name;
+    name << "tracks_" << count;
+    OneDimBuffer< out::VertexTrack > buffer(file, name.str(), out::type(out::VertexTrack()), 10000);
+
+    for(event = 0; event < settings.warmup; ++event)
+    {
+      jet = event % kJets;
+      for(track = 0; track < count; ++track) buffer.push_back(rows[jet][track]);
+    }
+    buffer.flush();
+
+    stopWatch.Start();
+    for(event = settings.warmup; event < settings.warmup + settings.events; ++event)
+    {
+      jet = event % kJets;
+      for(track = 0; track < count; ++track) buffer.push_back(rows[jet][track]);
+    }
+    buffer.flush();
+    stopWatch.Stop();
+    result.bufferTime = stopWatch.RealTime();
+
+    buffer.close();
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// reads "name=value" arguments, returns false for an unknown name
+bool SetParameter(BenchSettings &settings, const char *argument)
+{
+  string name(argument), value;
+  size_t pos = name.find('=');
+
+  if(pos == string::npos) return false;
+
+  value = name.substr(pos + 1);
+  name = name.substr(0, pos);
+
+  if(name == "events") settings.events = atoll(value.c_str());
+  else if(name == "warmup") settings.warmup = atoll(value.c_str());
+  else if(name == "multiplicity") settings.multiplicities.assign(1, atof(value.c_str()));
+  else if(name == "sweep") ParseList(settings.multiplicities, value);
+  else if(name == "pileup") settings.pileUp = atof(value.c_str());
+  else if(name == "jets") settings.jets = atoi(value.c_str());
+  else if(name == "heavyflavour") settings.heavyFlavour = atof(value.c_str());
+  else if(name == "jetptmin") settings.jetPTMin = atof(value.c_str());
+  else if(name == "jetptslope") settings.jetPTSlope = atof(value.c_str());
+  else if(name == "seed") settings.seed = atoi(value.c_str());
+  else if(name == "tracks") ParseList(settings.tracks, value);
+  else return false;
+
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+// peak resident set size of the process in kB
+Long_t GetPeakMemory()
+{
+  struct rusage usage;
+
+  if(getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+
+#ifdef __APPLE__
+  return usage.ru_maxrss/1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+//---------------------------------------------------------------------------
+
+string EscapeJSON(const char *text)
+{
+  string result;
+
+  for(; *text; ++text)
+  {
+    if(*text == '"' || *text == '\\') result += '\\';
+    result += *text;
+  }
+
+  return result;
+}
+
+//---------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  char appName[] = "DelphesBench";
+  stringstream message;
+  TFile *outputFile = 0;
+  TStopwatch genStopWatch, procStopWatch, fillStopWatch, moduleStopWatch;
+  vector< ExRootTask * > modules;
+  vector< BenchPoint > points;
+  vector< KernelPoint > kernels;
+  vector< pair< Double_t, Double_t > > scaling;
+  ExRootTreeWriter *treeWriter = 0;
+  ExRootTreeBranch *branchEvent = 0;
+  ExRootConfReader *confReader = 0;
+  Delphes *modularDelphes = 0;
+  DelphesFactory *factory = 0;
+  TObjArray *stableParticleOutputArray = 0, *allParticleOutputArray = 0, *partonOutputArray = 0;
+  SyntheticGenerator *generator = 0;
+  DelphesEventPipeline *pipeline = 0;
+  DelphesEventRecord record;
+  HepMCEvent *element;
+  TIter *itTasks;
+  TObject *task;
+  BenchSettings settings;
+  BenchPoint total;
+  ofstream jsonFile;
+  ostream *json;
+  Double_t procTime, moduleTime, rate;
+  Long64_t eventCounter, blockSize;
+  Int_t i, prefetchEvents;
+  size_t point, module;
+  Bool_t timed;
+
+  if(argc < 4)
+  {
+    cout << " Usage: " << appName << " config_file" << " output_file" << " json_file" << " [parameter=value ...]" << endl;
+    cout << " config_file - configuration file in Tcl format," << endl;
+    cout << " output_file - output file in ROOT format," << endl;
+    cout << " json_file - timing report in JSON format, - for standard output," << endl;
+    cout << " parameters of the synthetic events:" << endl;
+    cout << "   events - number of timed events per point (default: MaxEvents or 1000)," << endl;
+    cout << "   warmup - number of events processed before the timing of each point starts (default: 10)," << endl;
+    cout << "   multiplicity - mean number of soft particles per interaction (default: 100)," << endl;
+    cout << "   sweep - comma separated list of multiplicities, one timing point for each," << endl;
+    cout << "   pileup - mean number of pile-up interactions (default: 0)," << endl;
+    cout << "   jets - number of jets per event (default: 4)," << endl;
+    cout << "   heavyflavour - fraction of b and c jets (default: 0.1)," << endl;
+    cout << "   jetptmin, jetptslope - jet pT is jetptmin plus an exponential of mean jetptslope in GeV (default: 20, 50)," << endl;
+    cout << "   seed - random seed of the generator (default: 1)," << endl;
+    cout << "   tracks - comma separated list of numbers of tracks per jet, times HighLevelTracking::fill" << endl;
+    cout << "            and the HDF5 track buffer for each (default: none)." << endl;
+    return 1;
+  }
+
+  signal(SIGINT, SignalHandler);
+
+  gROOT->SetBatch();
+
+  int appargc = 1;
+  char *appargv[] = {appName};
+  TApplication app(appName, &appargc, appargv);
+
+  try
+  {
+    confReader = new ExRootConfReader;
+    confReader->ReadFile(argv[1]);
+
+    settings.events = confReader->GetInt("::MaxEvents", 0);
+    if(settings.events <= 0) settings.events = 1000;
+    settings.warmup = 10;
+    settings.multiplicities.assign(1, 100.0);
+    settings.pileUp = 0.0;
+    settings.jets = 4;
+    settings.heavyFlavour = 0.1;
+    settings.jetPTMin = 20.0;
+    settings.jetPTSlope = 50.0;
+    settings.seed = 1;
+
+    for(i = 4; i < argc; ++i)
+    {
+      if(!SetParameter(settings, argv[i]))
+      {
+        message << "unknown parameter " << argv[i];
+        throw runtime_error(message.str());
+      }
+    }
+
+    if(settings.events <= 0 || settings.warmup < 0 || settings.multiplicities.empty() ||
+       settings.pileUp < 0.0 || settings.jets < 0 || settings.heavyFlavour < 0.0 || settings.heavyFlavour > 1.0)
+    {
+      throw runtime_error("invalid parameters of the synthetic events");
+    }
+
+    for(point = 0; point < settings.multiplicities.size(); ++point)
+    {
+      if(settings.multiplicities[point] < 0.0)
+      {
+        throw runtime_error("multiplicity must be zero or positive");
+      }
+    }
+
+    for(point = 0; point < settings.tracks.size(); ++point)
+    {
+      if(settings.tracks[point] < 0.0)
+      {
+        throw runtime_error("number of tracks must be zero or positive");
+      }
+    }
+
+    prefetchEvents = confReader->GetInt("::PrefetchEvents", 0);
+    if(prefetchEvents < 0)
+    {
+      throw runtime_error("PrefetchEvents must be zero or positive");
+    }
+
+    outputFile = TFile::Open(argv[2], "RECREATE");
+
+    if(outputFile == NULL)
+    {
+      message << "can't create output file " << argv[2];
+      throw runtime_error(message.str());
+    }
+
+    treeWriter = new ExRootTreeWriter(outputFile, "Delphes");
+
+    branchEvent = treeWriter->NewBranch("Event", HepMCEvent::Class());
+
+    modularDelphes = new Delphes("Delphes");
+    modularDelphes->SetConfReader(confReader);
+    modularDelphes->SetTreeWriter(treeWriter);
+
+    factory = modularDelphes->GetFactory();
+    allParticleOutputArray = modularDelphes->ExportArray("allParticles");
+    stableParticleOutputArray = modularDelphes->ExportArray("stableParticles");
+    partonOutputArray = modularDelphes->ExportArray("partons");
+
+    generator = new SyntheticGenerator(settings);
+
+    // generate the events on a separate thread, up to prefetchEvents ahead
+    if(prefetchEvents > 0) pipeline = new DelphesEventPipeline(generator, prefetchEvents);
+
+    modularDelphes->InitTask();
+
+    // the modules are run one by one to time them separately
+    itTasks = new TIter(modularDelphes->GetListOfTasks());
+    while((task = itTasks->Next()))
+    {
+      modules.push_back(static_cast<ExRootTask *>(task));
+    }
+    delete itTasks;
+
+    points.resize(settings.multiplicities.size());
+    for(point = 0; point < points.size(); ++point)
+    {
+      BenchPoint &result = points[point];
+      result.multiplicity = settings.multiplicities[point];
+      result.events = 0;
+      result.particles = 0;
+      result.genTime = 0.0;
+      result.procTime = 0.0;
+      result.procCpuTime = 0.0;
+      result.fillTime = 0.0;
+      result.moduleTime.assign(modules.size(), 0.0);
+      result.moduleCpuTime.assign(modules.size(), 0.0);
+    }
+
+    if(pipeline) pipeline->Start();
+
+    blockSize = settings.events + settings.warmup;
+
+    ExRootProgressBar progressBar(blockSize*Long64_t(points.size()));
+
+    eventCounter = 0;
+
+    treeWriter->Clear();
+    modularDelphes->Clear();
+    genStopWatch.Start();
+    while((pipeline ? pipeline->Next(record) : generator->ReadEvent(record)) && !interrupted)
+    {
+      genStopWatch.Stop();
+
+      // the warm-up events of every point are not timed,
+      // they fill the caches and the memory pools
+      point = eventCounter/blockSize;
+      timed = eventCounter%blockSize >= settings.warmup;
+      BenchPoint &result = points[point];
+
+      ++eventCounter;
+
+      record.Materialize(factory, allParticleOutputArray,
+        stableParticleOutputArray, partonOutputArray);
+
+      procStopWatch.Start();
+      for(module = 0; module < modules.size(); ++module)
+      {
+        if(!modules[module]->IsActive()) continue;
+        moduleStopWatch.Start();
+        modules[module]->ProcessTask();
+        moduleStopWatch.Stop();
+        if(timed)
+        {
+          result.moduleTime[module] += moduleStopWatch.RealTime();
+          result.moduleCpuTime[module] += moduleStopWatch.CpuTime();
+        }
+      }
+      procStopWatch.Stop();
+
+      element = static_cast<HepMCEvent *>(branchEvent->NewEntry());
+      element->Number = record.Number;
+      element->Weight = record.Weight;
+      element->ReadTime = genStopWatch.RealTime();
+      element->ProcTime = procStopWatch.RealTime();
+
+      fillStopWatch.Start();
+      treeWriter->Fill();
+      treeWriter->Clear();
+      modularDelphes->Clear();
+      fillStopWatch.Stop();
+
+      if(timed)
+      {
+        ++result.events;
+        result.particles += record.Size();
+        result.genTime += genStopWatch.RealTime();
+        result.procTime += procStopWatch.RealTime();
+        result.procCpuTime += procStopWatch.CpuTime();
+        result.fillTime += fillStopWatch.RealTime();
+      }
+
+      genStopWatch.Start();
+      progressBar.Update(eventCounter, eventCounter);
+    }
+    genStopWatch.Stop();
+
+    progressBar.Update(eventCounter, eventCounter, kTRUE);
+    progressBar.Finish();
+
+    if(pipeline) pipeline->Stop();
+
+    modularDelphes->FinishTask();
+    treeWriter->Write();
+
+    if(!settings.tracks.empty() && !interrupted)
+    {
+      cout << "** Timing the jet kernels" << endl;
+      try
+      {
+        TimeKernels(settings, kernels);
+      }
+      catch(H5::Exception &e)
+      {
+        throw runtime_error(e.getDetailMsg());
+      }
+    }
+
+    // sum of all points
+
+    total = points[0];
+    for(point = 1; point < points.size(); ++point)
+    {
+      total.events += points[point].events;
+      total.particles += points[point].particles;
+      total.genTime += points[point].genTime;
+      total.procTime += points[point].procTime;
+      total.procCpuTime += points[point].procCpuTime;
+      total.fillTime += points[point].fillTime;
+      for(module = 0; module < modules.size(); ++module)
+      {
+        total.moduleTime[module] += points[point].moduleTime[module];
+        total.moduleCpuTime[module] += points[point].moduleCpuTime[module];
+      }
+    }
+
+    // report
+
+    procTime = total.procTime + total.fillTime;
+    rate = procTime > 0.0 ? total.events/procTime : 0.0;
+
+    if(strncmp(argv[3], "-", 2) == 0)
+    {
+      json = &cout;
+    }
+    else
+    {
+      jsonFile.open(argv[3]);
+      if(!jsonFile)
+      {
+        message << "can't create JSON file " << argv[3];
+        throw runtime_error(message.str());
+      }
+      json = &jsonFile;
+    }
+
+    *json << setprecision(6);
+    *json << "{" << endl;
+    *json << "  \"card\": \"" << EscapeJSON(argv[1]) << "\"," << endl;
+    *json << "  \"host\": \"" << EscapeJSON(gSystem->HostName()) << "\"," << endl;
+    *json << "  \"generator\": {" << endl;
+    *json << "    \"events\": " << settings.events << "," << endl;
+    *json << "    \"warmup\": " << settings.warmup << "," << endl;
+    *json << "    \"multiplicity\": [";
+    for(point = 0; point < points.size(); ++point)
+    {
+      *json << (point > 0 ? ", " : "") << points[point].multiplicity;
+    }
+    *json << "]," << endl;
+    *json << "    \"pileup\": " << settings.pileUp << "," << endl;
+    *json << "    \"jets\": " << settings.jets << "," << endl;
+    *json << "    \"heavy_flavour\": " << settings.heavyFlavour << "," << endl;
+    *json << "    \"jet_pt_min\": " << settings.jetPTMin << "," << endl;
+    *json << "    \"jet_pt_slope\": " << settings.jetPTSlope << "," << endl;
+    *json << "    \"seed\": " << settings.seed << "," << endl;
+    *json << "    \"prefetch\": " << prefetchEvents << endl;
+    *json << "  }," << endl;
+    *json << "  \"events\": " << total.events << "," << endl;
+    *json << "  \"particles_per_event\": " << (total.events > 0 ? Double_t(total.particles)/total.events : 0.0) << "," << endl;
+    *json << "  \"real_time\": " << procTime << "," << endl;
+    *json << "  \"cpu_time\": " << total.procCpuTime << "," << endl;
+    *json << "  \"events_per_second\": " << rate << "," << endl;
+    *json << "  \"generation_time\": " << total.genTime << "," << endl;
+    *json << "  \"output_time\": " << total.fillTime << "," << endl;
+    *json << "  \"peak_rss_kb\": " << GetPeakMemory() << "," << endl;
+
+    // time per event of every module, and its exponent in the number of
+    // particles when several multiplicities are timed
+    *json << "  \"modules\": [" << endl;
+    for(module = 0; module < modules.size(); ++module)
+    {
+      moduleTime = total.moduleTime[module];
+      *json << "    {\"name\": \"" << EscapeJSON(modules[module]->GetName()) << "\"";
+      *json << ", \"class\": \"" << EscapeJSON(modules[module]->ClassName()) << "\"";
+      *json << ", \"real_time\": " << moduleTime;
+      *json << ", \"cpu_time\": " << total.moduleCpuTime[module];
+      *json << ", \"events_per_second\": " << (moduleTime > 0.0 ? total.events/moduleTime : 0.0);
+      *json << ", \"fraction\": " << (procTime > 0.0 ? moduleTime/procTime : 0.0);
+      if(points.size() > 1)
+      {
+        scaling.clear();
+        for(point = 0; point < points.size(); ++point)
+        {
+          if(points[point].events == 0) continue;
+          scaling.push_back(make_pair(Double_t(points[point].particles)/points[point].events,
+            points[point].moduleTime[module]/points[point].events));
+        }
+        *json << ", \"scaling\": " << GetScaling(scaling);
+      }
+      *json << "}" << (module + 1 < modules.size() ? "," : "") << endl;
+    }
+    *json << "  ]," << endl;
+
+    *json << "  \"points\": [" << endl;
+    for(point = 0; point < points.size(); ++point)
+    {
+      const BenchPoint &result = points[point];
+      procTime = result.procTime + result.fillTime;
+      *json << "    {\"multiplicity\": " << result.multiplicity;
+      *json << ", \"events\": " << result.events;
+      *json << ", \"particles_per_event\": " << (result.events > 0 ? Double_t(result.particles)/result.events : 0.0);
+      *json << ", \"events_per_second\": " << (procTime > 0.0 ? result.events/procTime : 0.0);
+      *json << ", \"module_time_per_event\": [";
+      for(module = 0; module < modules.size(); ++module)
+      {
+        *json << (module > 0 ? ", " : "") << (result.events > 0 ? result.moduleTime[module]/result.events : 0.0);
+      }
+      *json << "]}" << (point + 1 < points.size() ? "," : "") << endl;
+    }
+    *json << "  ]" << (kernels.empty() ? "" : ",") << endl;
+
+    // time per jet of the kernels, and their exponent in the number of tracks
+    if(!kernels.empty())
+    {
+      *json << "  \"kernels\": {" << endl;
+      *json << "    \"points\": [" << endl;
+      for(point = 0; point < kernels.size(); ++point)
+      {
+        const KernelPoint &result = kernels[point];
+        *json << "      {\"tracks\": " << result.tracks;
+        *json << ", \"jets\": " << result.jets;
+        *json << ", \"fill_time_per_jet\": " << (result.jets > 0 ? result.fillTime/result.jets : 0.0);
+        *json << ", \"buffer_time_per_jet\": " << (result.jets > 0 ? result.bufferTime/result.jets : 0.0);
+        *json << "}" << (point + 1 < kernels.size() ? "," : "") << endl;
+      }
+      *json << "    ]," << endl;
+
+      scaling.clear();
+      for(point = 0; point < kernels.size(); ++point)
+      {
+        if(kernels[point].jets == 0) continue;
+        scaling.push_back(make_pair(Double_t(kernels[point].tracks), kernels[point].fillTime/kernels[point].jets));
+      }
+      *json << "    \"fill_scaling\": " << GetScaling(scaling) << "," << endl;
+
+      scaling.clear();
+      for(point = 0; point < kernels.size(); ++point)
+      {
+        if(kernels[point].jets == 0) continue;
+        scaling.push_back(make_pair(Double_t(kernels[point].tracks), kernels[point].bufferTime/kernels[point].jets));
+      }
+      *json << "    \"buffer_scaling\": " << GetScaling(scaling) << endl;
+      *json << "  }" << endl;
+    }
+
+    *json << "}" << endl;
+
+    if(jsonFile.is_open()) jsonFile.close();
+
+    cout << "** " << total.events << " events processed in " << total.procTime + total.fillTime << " s, ";
+    cout << rate << " events/s, peak memory " << GetPeakMemory()/1024 << " MB" << endl;
+
+    cout << "** Exiting..." << endl;
+
+    if(pipeline) delete pipeline;
+    delete generator;
+    delete modularDelphes;
+    delete confReader;
+    delete treeWriter;
+    delete outputFile;
+
+    return 0;
+  }
+  catch(runtime_error &e)
+  {
+    if(pipeline) delete pipeline;
+    if(treeWriter) delete treeWriter;
+    if(outputFile) delete outputFile;
+    cerr << "** ERROR: " << e.what() << endl;
+    return 1;
+  }
+}
@@ -35,14 +35,13 @@
 #include "TFile.h"
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "modules/Delphes.h"
 #include "classes/DelphesStream.h"
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesPDGTable.h"
 
 #include "ExRootAnalysis/ExRootTreeWriter.h"
 #include "ExRootAnalysis/ExRootTreeBranch.h"
@@ -84,8 +83,8 @@ void ConvertInput(fwlite::Event &event, Long64_t eventCounter,
   HepMCEvent *element;
   Weight *weight;
   Candidate *candidate;
-  TDatabasePDG *pdg;
-  TParticlePDG *pdgParticle;
+  const DelphesPDGTable *pdg;
+  const DelphesPDGTable::Entry *pdgParticle;
   Int_t pdgCode;
 
   Int_t pid, status;
@@ -123,7 +122,7 @@ void ConvertInput(fwlite::Event &event, Long64_t eventCounter,
     weight->Weight = itWeightsInfo->wgt;
   }
 
-  pdg = TDatabasePDG::Instance();
+  pdg = &DelphesPDGTable::Instance();
 
   for(itParticle = handleParticle->begin(); itParticle != handleParticle->end(); ++itParticle)
   {
@@ -158,8 +157,8 @@ void ConvertInput(fwlite::Event &event, Long64_t eventCounter,
     itCandidate = find(vectorCandidate.begin(), vectorCandidate.end(), particle.daughter(particle.numberOfDaughters() - 1));
     if(itCandidate != vectorCandidate.end()) candidate->D2 = distance(vectorCandidate.begin(), itCandidate);
 
-    pdgParticle = pdg->GetParticle(pid);
-    candidate->Charge = pdgParticle ? Int_t(pdgParticle->Charge()/3.0) : -999;
+    pdgParticle = pdg->GetEntry(pid);
+    candidate->Charge = pdgParticle ? pdgParticle->Charge : -999;
     candidate->Mass = mass;
 
     candidate->Momentum.SetPxPyPzE(px, py, pz, e);
@@ -36,6 +36,9 @@
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
 #include "classes/DelphesLHEFReader.h"
+#include "classes/DelphesEventRecord.h"
+#include "classes/DelphesEventPipeline.h"
+#include "classes/DelphesEventIndex.h"
 
 #include "ExRootAnalysis/ExRootTreeWriter.h"
 #include "ExRootAnalysis/ExRootTreeBranch.h"
@@ -68,7 +71,11 @@ int main(int argc, char *argv[])
   DelphesFactory *factory = 0;
   TObjArray *stableParticleOutputArray = 0, *allParticleOutputArray = 0, *partonOutputArray = 0;
   DelphesLHEFReader *reader = 0;
-  Int_t i, maxEvents, skipEvents;
+  DelphesEventPipeline *pipeline = 0;
+  DelphesEventRecord record;
+  DelphesEventIndex index;
+  Bool_t useIndex, buildIndex, lazyParticles;
+  Int_t i, maxEvents, skipEvents, prefetchEvents;
   Long64_t length, eventCounter;
 
   if(argc < 3)
@@ -109,6 +116,9 @@ int main(int argc, char *argv[])
 
     maxEvents = confReader->GetInt("::MaxEvents", 0);
     skipEvents = confReader->GetInt("::SkipEvents", 0);
+    prefetchEvents = confReader->GetInt("::PrefetchEvents", 0);
+    useIndex = confReader->GetBool("::EventIndex", false);
+    lazyParticles = confReader->GetBool("::LazyParticles", false);
 
     if(maxEvents < 0)
     {
@@ -120,6 +130,11 @@ int main(int argc, char *argv[])
       throw runtime_error("SkipEvents must be zero or positive");
     }
 
+    if(prefetchEvents < 0)
+    {
+      throw runtime_error("PrefetchEvents must be zero or positive");
+    }
+
     modularDelphes = new Delphes("Delphes");
     modularDelphes->SetConfReader(confReader);
     modularDelphes->SetTreeWriter(treeWriter);
@@ -129,8 +144,15 @@ int main(int argc, char *argv[])
     stableParticleOutputArray = modularDelphes->ExportArray("stableParticles");
     partonOutputArray = modularDelphes->ExportArray("partons");
 
+    // only stable particles and partons go to allParticles, the other
+    // particles are created when a module asks the factory for them
+    if(lazyParticles) factory->SetEventRecord(&record);
+
     reader = new DelphesLHEFReader;
 
+    // decode the input on a separate thread, up to prefetchEvents ahead
+    if(prefetchEvents > 0) pipeline = new DelphesEventPipeline(reader, prefetchEvents);
+
     modularDelphes->InitTask();
 
     i = 3;
@@ -168,48 +190,75 @@ int main(int argc, char *argv[])
       }
 
       reader->SetInputFile(inputFile);
+      reader->Clear();
+
+      // with an index, jump directly to the first event to process,
+      // otherwise record the index while reading the whole file
+      eventCounter = 0;
+      buildIndex = kFALSE;
+      if(useIndex && inputFile != stdin)
+      {
+        if(index.Load(argv[i]))
+        {
+          eventCounter = index.Seek(inputFile, skipEvents);
+        }
+        else
+        {
+          buildIndex = kTRUE;
+        }
+      }
+
+      if(pipeline) pipeline->Start();
 
       ExRootProgressBar progressBar(length);
 
       // Loop over all objects
-      eventCounter = 0;
       treeWriter->Clear();
       modularDelphes->Clear();
-      reader->Clear();
       readStopWatch.Start();
       while((maxEvents <= 0 || eventCounter - skipEvents < maxEvents) &&
-        reader->ReadBlock(factory, allParticleOutputArray,
-        stableParticleOutputArray, partonOutputArray) && !interrupted)
+        (pipeline ? pipeline->Next(record) : reader->ReadEvent(record)) && !interrupted)
       {
-        if(reader->EventReady())
-        {
-          ++eventCounter;
+        ++eventCounter;
 
-          readStopWatch.Stop();
+        readStopWatch.Stop();
 
-          if(eventCounter > skipEvents)
-          {
-            readStopWatch.Stop();
-            procStopWatch.Start();
-            modularDelphes->ProcessTask();
-            procStopWatch.Stop();
+        if(buildIndex) index.Add(record.Offset);
 
-            reader->AnalyzeEvent(branchEvent, eventCounter, &readStopWatch, &procStopWatch);
-            reader->AnalyzeWeight(branchWeight);
+        if(eventCounter > skipEvents)
+        {
+          record.Materialize(factory, allParticleOutputArray,
+            stableParticleOutputArray, partonOutputArray, lazyParticles);
 
-            treeWriter->Fill();
+          procStopWatch.Start();
+          modularDelphes->ProcessTask();
+          procStopWatch.Stop();
 
-            treeWriter->Clear();
-          }
+          reader->AnalyzeEvent(branchEvent, record, eventCounter, &readStopWatch, &procStopWatch);
+          reader->AnalyzeWeight(branchWeight, record);
 
-          modularDelphes->Clear();
-          reader->Clear();
+          treeWriter->Fill();
 
-          readStopWatch.Start();
+          treeWriter->Clear();
         }
+
+        modularDelphes->Clear();
+
+        readStopWatch.Start();
         progressBar.Update(ftello(inputFile), eventCounter);
       }
 
+      if(pipeline) pipeline->Stop();
+
+      if(buildIndex && !interrupted && (maxEvents <= 0 || eventCounter - skipEvents < maxEvents))
+      {
+        cout << "** Writing " << DelphesEventIndex::GetIndexName(argv[i]) << endl;
+        if(!index.Save(argv[i]))
+        {
+          cerr << "** WARNING: can't write " << DelphesEventIndex::GetIndexName(argv[i]) << endl;
+        }
+      }
+
       fseek(inputFile, 0L, SEEK_END);
       progressBar.Update(ftello(inputFile), eventCounter, kTRUE);
       progressBar.Finish();
@@ -225,6 +274,7 @@ int main(int argc, char *argv[])
 
     cout << "** Exiting..." << endl;
 
+    if(pipeline) delete pipeline;
     delete reader;
     delete modularDelphes;
     delete confReader;
@@ -235,6 +285,7 @@ int main(int argc, char *argv[])
   }
   catch(runtime_error &e)
   {
+    if(pipeline) delete pipeline;
     if(treeWriter) delete treeWriter;
     if(outputFile) delete outputFile;
     cerr << "** ERROR: " << e.what() << endl;
@@ -0,0 +1,494 @@
+/*
+ *  Delphes: a framework for fast simulation of a generic collider experiment
+ *  Copyright (C) 2012-2014  Universite catholique de Louvain (UCL), Belgium
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ *  Runs one of the Delphes readers in several worker processes, each one
+ *  on its own range of events and with its own random seed, then merges
+ *  the ROOT trees, the HDF5 files and the text files of the workers into
+ *  a single output. With EventIndex set, the input files are indexed first,
+ *  so that each worker can jump directly to its first event.
+ *
+ *  The readers count SkipEvents and MaxEvents separately in every input
+ *  file, so with several input files the events are numbered across all
+ *  the files and each range is cut at the file boundaries: every piece is
+ *  run by its own worker on a single file, with at most n_workers workers
+ *  running at the same time.
+ */
+
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TMath.h"
+#include "TString.h"
+#include "TFileMerger.h"
+
+#include "classes/DelphesReader.h"
+#include "classes/DelphesEventIndex.h"
+#include "classes/DelphesSTDHEPReader.h"
+#include "classes/DelphesHepMCReader.h"
+#include "classes/DelphesLHEFReader.h"
+
+#include "ExRootAnalysis/ExRootConfReader.h"
+
+#include "external/h5/h5merge.hh"
+
+using namespace std;
+
+//---------------------------------------------------------------------------
+
+static vector<pid_t> workers;
+
+void SignalHandler(int sig)
+{
+  for(size_t i = 0; i < workers.size(); ++i)
+  {
+    if(workers[i] > 0) kill(workers[i], sig);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// waits for one of the workers to finish, returns false if it failed
+bool WaitWorker(const vector<TString> &shardNames)
+{
+  int status;
+  size_t k;
+  pid_t pid = waitpid(-1, &status, 0);
+
+  if(pid < 0) return false;
+
+  for(k = 0; k < workers.size() && workers[k] != pid; ++k) continue;
+  if(k == workers.size()) return false;
+
+  workers[k] = 0;
+
+  if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+  {
+    cerr << "** ERROR: worker " << k << " failed, see " << shardNames[k] << ".log" << endl;
+    return false;
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+// all the files written by the first worker, apart from its ROOT file,
+// card and log, given as suffixes to the worker output name
+vector<TString> GetSideFiles(const TString &shardName)
+{
+  vector<TString> suffixes;
+  TString dirName = gSystem->DirName(shardName);
+  TString baseName = gSystem->BaseName(shardName);
+  TString entry;
+  const char *name;
+
+  void *dir = gSystem->OpenDirectory(dirName);
+  if(!dir) return suffixes;
+
+  while((name = gSystem->GetDirEntry(dir)))
+  {
+    entry = name;
+    if(!entry.BeginsWith(baseName)) continue;
+    entry.Remove(0, baseName.Length());
+    if(entry == ".root" || entry == ".tcl" || entry == ".log") continue;
+    suffixes.push_back(entry);
+  }
+  gSystem->FreeDirectory(dir);
+
+  return suffixes;
+}
+
+//---------------------------------------------------------------------------
+
+void Concatenate(const vector<string> &inputs, const string &output)
+{
+  stringstream message;
+  ofstream outputStream(output.c_str(), ios::out | ios::binary);
+  if(!outputStream.is_open())
+  {
+    message << "can't create output file " << output;
+    throw runtime_error(message.str());
+  }
+  for(size_t i = 0; i < inputs.size(); ++i)
+  {
+    ifstream inputStream(inputs[i].c_str(), ios::in | ios::binary);
+    if(inputStream.is_open()) outputStream << inputStream.rdbuf();
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// reader used by the given Delphes executable, if it supports event indices
+DelphesReader *NewReader(const char *executable)
+{
+  TString name = gSystem->BaseName(executable);
+  if(name == "DelphesSTDHEP") return new DelphesSTDHEPReader;
+  if(name == "DelphesHepMC") return new DelphesHepMCReader;
+  if(name == "DelphesLHEF") return new DelphesLHEFReader;
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+
+// number of events in the input file, taken from its index or counted
+// by reading the file once, and -1 if the file can't be read;
+// a new index is written next to the file only if save is true
+Long64_t IndexInput(DelphesReader *reader, const char *fileName, bool save)
+{
+  DelphesEventIndex index;
+  FILE *inputFile;
+
+  if(strncmp(fileName, "-", 2) == 0) return -1;
+
+  if(index.Load(fileName)) return index.GetEntries();
+
+  inputFile = fopen(fileName, "r");
+  if(!inputFile) return -1;
+
+  cout << "** Indexing " << fileName << endl;
+  index.Build(reader, inputFile);
+  fclose(inputFile);
+
+  if(save && !index.Save(fileName))
+  {
+    cerr << "** WARNING: can't write " << DelphesEventIndex::GetIndexName(fileName) << endl;
+  }
+
+  return index.GetEntries();
+}
+
+//---------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+  char appName[] = "DelphesParallel";
+  stringstream message;
+  ExRootConfReader *confReader = 0;
+  DelphesReader *reader = 0;
+  Int_t i, j, k, workerCount, shardCount, inputCount, running, failures;
+  Int_t maxEvents, skipEvents, randomSeed;
+  Long64_t firstEvent, eventCount, fileFirst, fileLast, first, last, totalEvents;
+  Bool_t useIndex;
+  TString outputName, outputBase, shardName;
+  vector<TString> shardNames, sideFiles;
+  vector<Int_t> shardInputs;
+  vector<Long64_t> shardFirst, shardEvents, fileEvents;
+  pid_t pid;
+
+  if(argc < 5)
+  {
+    cout << " Usage: " << appName << " n_workers reader config_file output_file [input_file(s)]" << endl;
+    cout << " n_workers - number of worker processes," << endl;
+    cout << " reader - Delphes reader executable (DelphesSTDHEP, DelphesHepMC, DelphesLHEF...)," << endl;
+    cout << " config_file - configuration file in Tcl format," << endl;
+    cout << " output_file - output file in ROOT format," << endl;
+    cout << " input_file(s) - input file(s) in the format of the reader." << endl;
+    cout << " The total number of events is given by MaxEvents in config_file." << endl;
+    cout << " With several input files, the events are counted across all of them." << endl;
+    return 1;
+  }
+
+  signal(SIGINT, SignalHandler);
+  signal(SIGTERM, SignalHandler);
+
+  gROOT->SetBatch();
+
+  try
+  {
+    workerCount = atoi(argv[1]);
+    if(workerCount <= 0)
+    {
+      throw runtime_error("number of workers must be positive");
+    }
+
+    outputName = argv[4];
+    if(!gSystem->AccessPathName(outputName))
+    {
+      message << "output file " << outputName << " already exists";
+      throw runtime_error(message.str());
+    }
+
+    outputBase = outputName;
+    if(outputBase.EndsWith(".root")) outputBase.Remove(outputBase.Length() - 5);
+
+    ofstream blackHole("/dev/null");
+    confReader = new ExRootConfReader(blackHole.rdbuf());
+    confReader->ReadFile(argv[3]);
+
+    maxEvents = confReader->GetInt("::MaxEvents", 0);
+    skipEvents = confReader->GetInt("::SkipEvents", 0);
+    randomSeed = confReader->GetInt("::RandomSeed", 0);
+
+    if(maxEvents <= 0)
+    {
+      throw runtime_error("MaxEvents must be set to the total number of events to process");
+    }
+
+    if(skipEvents < 0)
+    {
+      throw runtime_error("SkipEvents must be zero or positive");
+    }
+
+    inputCount = argc - 5;
+    useIndex = confReader->GetBool("::EventIndex", false);
+
+    // without an index, every worker would decode all the events before its range,
+    // with several input files the number of events of each file is needed anyway
+    reader = NewReader(argv[2]);
+    if(inputCount > 1)
+    {
+      if(!reader)
+      {
+        message << "several input files can only be split with DelphesSTDHEP, DelphesHepMC or DelphesLHEF";
+        throw runtime_error(message.str());
+      }
+
+      totalEvents = 0;
+      for(i = 5; i < argc; ++i)
+      {
+        eventCount = IndexInput(reader, argv[i], useIndex);
+        if(eventCount < 0)
+        {
+          message << "can't read " << argv[i];
+          throw runtime_error(message.str());
+        }
+        fileEvents.push_back(eventCount);
+        totalEvents += eventCount;
+      }
+
+      if(skipEvents >= totalEvents)
+      {
+        throw runtime_error("SkipEvents is beyond the last event of the input files");
+      }
+
+      if(skipEvents + maxEvents > totalEvents)
+      {
+        maxEvents = totalEvents - skipEvents;
+        cout << "** Only " << maxEvents << " events left in the input files" << endl;
+      }
+    }
+    else if(useIndex && reader && inputCount == 1)
+    {
+      IndexInput(reader, argv[5], kTRUE);
+    }
+    if(reader) delete reader;
+    reader = 0;
+
+    if(workerCount > maxEvents) workerCount = maxEvents;
+
+    // one range of events per worker, cut at the boundaries of the input files
+    firstEvent = skipEvents;
+    for(k = 0; k < workerCount; ++k)
+    {
+      eventCount = maxEvents / workerCount + (k < maxEvents % workerCount ? 1 : 0);
+
+      if(inputCount <= 1)
+      {
+        shardInputs.push_back(-1);
+        shardFirst.push_back(firstEvent);
+        shardEvents.push_back(eventCount);
+      }
+      else
+      {
+        fileFirst = 0;
+        for(j = 0; j < inputCount; ++j)
+        {
+          fileLast = fileFirst + fileEvents[j];
+          first = TMath::Max(firstEvent, fileFirst);
+          last = TMath::Min(firstEvent + eventCount, fileLast);
+          if(first < last)
+          {
+            shardInputs.push_back(j);
+            shardFirst.push_back(first - fileFirst);
+            shardEvents.push_back(last - first);
+          }
+          fileFirst = fileLast;
+        }
+      }
+
+      firstEvent += eventCount;
+    }
+
+    shardCount = shardInputs.size();
+    workers.assign(shardCount, 0);
+
+    ifstream cardStream(argv[3]);
+    stringstream card;
+    card << cardStream.rdbuf();
+
+    // start one worker per range of events, the workers get independent
+    // random seeds (unless the seed is taken from the clock)
+    running = 0;
+    failures = 0;
+    for(k = 0; k < shardCount; ++k)
+    {
+      // keep at most workerCount workers running
+      if(running == workerCount)
+      {
+        if(!WaitWorker(shardNames)) ++failures;
+        --running;
+      }
+
+      shardName = outputBase + TString::Format("_shard%d", k);
+      shardNames.push_back(shardName);
+
+      ofstream shardCard((shardName + ".tcl").Data());
+      shardCard << card.str() << endl;
+      shardCard << "set SkipEvents " << shardFirst[k] << endl;
+      shardCard << "set MaxEvents " << shardEvents[k] << endl;
+      shardCard << "set RandomSeed " << (randomSeed == 0 ? 0 : randomSeed + k) << endl;
+      shardCard.close();
+
+      gSystem->Unlink(shardName + ".root");
+
+      cout << "** Starting worker " << k << " for events ";
+      cout << shardFirst[k] << " to " << shardFirst[k] + shardEvents[k] - 1;
+      if(shardInputs[k] >= 0) cout << " of " << argv[5 + shardInputs[k]];
+      cout << endl;
+
+      pid = fork();
+      if(pid < 0)
+      {
+        throw runtime_error("can't start worker process");
+      }
+      else if(pid == 0)
+      {
+        int log = open(shardName + ".log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(log >= 0)
+        {
+          dup2(log, STDOUT_FILENO);
+          dup2(log, STDERR_FILENO);
+          close(log);
+        }
+
+        vector<char *> arguments;
+        arguments.push_back(argv[2]);
+        arguments.push_back(strdup(shardName + ".tcl"));
+        arguments.push_back(strdup(shardName + ".root"));
+        if(shardInputs[k] >= 0)
+        {
+          arguments.push_back(argv[5 + shardInputs[k]]);
+        }
+        else
+        {
+          for(i = 5; i < argc; ++i) arguments.push_back(argv[i]);
+        }
+        arguments.push_back(0);
+
+        execvp(argv[2], &arguments[0]);
+        cerr << "** ERROR: can't execute " << argv[2] << endl;
+        _exit(127);
+      }
+
+      workers[k] = pid;
+      ++running;
+    }
+
+    for(; running > 0; --running)
+    {
+      if(!WaitWorker(shardNames)) ++failures;
+    }
+    workers.clear();
+
+    if(failures > 0)
+    {
+      throw runtime_error("not merging the output of the workers");
+    }
+
+    cout << "** Merging " << outputName << endl;
+
+    TFileMerger merger(kFALSE);
+    if(!merger.OutputFile(outputName, "CREATE"))
+    {
+      message << "can't create output file " << outputName;
+      throw runtime_error(message.str());
+    }
+    for(k = 0; k < shardCount; ++k)
+    {
+      merger.AddFile(shardNames[k] + ".root");
+    }
+    if(!merger.Merge())
+    {
+      throw runtime_error("can't merge the output of the workers");
+    }
+
+    // HDF5 and text files written next to the ROOT file
+    sideFiles = GetSideFiles(shardNames[0]);
+    for(i = 0; i < Int_t(sideFiles.size()); ++i)
+    {
+      vector<string> inputs;
+      for(k = 0; k < shardCount; ++k)
+      {
+        inputs.push_back((shardNames[k] + sideFiles[i]).Data());
+      }
+
+      cout << "** Merging " << outputBase + sideFiles[i] << endl;
+
+      if(sideFiles[i].EndsWith(".h5"))
+      {
+        h5::merge(inputs, (outputBase + sideFiles[i]).Data());
+      }
+      else
+      {
+        Concatenate(inputs, (outputBase + sideFiles[i]).Data());
+      }
+
+      for(k = 0; k < shardCount; ++k) gSystem->Unlink(inputs[k].c_str());
+    }
+
+    for(k = 0; k < shardCount; ++k)
+    {
+      gSystem->Unlink(shardNames[k] + ".root");
+      gSystem->Unlink(shardNames[k] + ".tcl");
+    }
+
+    cout << "** Exiting..." << endl;
+
+    delete confReader;
+
+    return 0;
+  }
+  catch(exception &e)
+  {
+    SignalHandler(SIGTERM);
+    if(confReader) delete confReader;
+    cerr << "** ERROR: " << e.what() << endl;
+    return 1;
+  }
+  catch(H5::Exception &e)
+  {
+    if(confReader) delete confReader;
+    cerr << "** ERROR: " << e.getDetailMsg() << endl;
+    return 1;
+  }
+}
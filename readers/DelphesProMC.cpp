@@ -33,14 +33,13 @@
 #include "TFile.h"
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "modules/Delphes.h"
 #include "classes/DelphesStream.h"
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesPDGTable.h"
 
 #include "ExRootAnalysis/ExRootTreeWriter.h"
 #include "ExRootAnalysis/ExRootTreeBranch.h"
@@ -66,15 +65,15 @@ void ConvertInput(ProMCEvent &event, double momentumUnit, double positionUnit,
 
   HepMCEvent *element;
   Candidate *candidate;
-  TDatabasePDG *pdg;
-  TParticlePDG *pdgParticle;
+  const DelphesPDGTable *pdg;
+  const DelphesPDGTable::Entry *pdgParticle;
   Int_t pdgCode;
 
   Int_t pid, status;
   Double_t px, py, pz, mass;
   Double_t x, y, z, t;
 
-  pdg = TDatabasePDG::Instance();
+  pdg = &DelphesPDGTable::Instance();
 
   // event information
   mutableEvent = event.mutable_event();
@@ -130,8 +129,8 @@ void ConvertInput(ProMCEvent &event, double momentumUnit, double positionUnit,
     candidate->D1 = mutableParticles->daughter1(i);
     candidate->D2 = mutableParticles->daughter2(i);
 
-    pdgParticle = pdg->GetParticle(pid);
-    candidate->Charge = pdgParticle ? Int_t(pdgParticle->Charge()/3.0) : -999;
+    pdgParticle = pdg->GetEntry(pid);
+    candidate->Charge = pdgParticle ? pdgParticle->Charge : -999;
     candidate->Mass = mass;
 
     candidate->Momentum.SetXYZM(px, py, pz, mass);
@@ -20,6 +20,8 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
+#include <atomic>
 
 #include <signal.h>
 
@@ -31,14 +33,17 @@
 #include "TFile.h"
 #include "TObjArray.h"
 #include "TStopwatch.h"
-#include "TDatabasePDG.h"
-#include "TParticlePDG.h"
 #include "TLorentzVector.h"
 
 #include "modules/Delphes.h"
 #include "classes/DelphesClasses.h"
 #include "classes/DelphesFactory.h"
+#include "classes/DelphesPDGTable.h"
 #include "classes/DelphesLHEFReader.h"
+#include "classes/DelphesReader.h"
+#include "classes/DelphesEventRecord.h"
+#include "classes/DelphesEventPipeline.h"
+#include "classes/DelphesPythia8Seed.h"
 
 #include "ExRootAnalysis/ExRootTreeWriter.h"
 #include "ExRootAnalysis/ExRootTreeBranch.h"
@@ -57,8 +62,8 @@ void ConvertInput(Long64_t eventCounter, Pythia8::Pythia *pythia,
 
   HepMCEvent *element;
   Candidate *candidate;
-  TDatabasePDG *pdg;
-  TParticlePDG *pdgParticle;
+  const DelphesPDGTable *pdg;
+  const DelphesPDGTable::Entry *pdgParticle;
   Int_t pdgCode;
 
   Int_t pid, status;
@@ -88,7 +93,7 @@ void ConvertInput(Long64_t eventCounter, Pythia8::Pythia *pythia,
   element->ReadTime = readStopWatch->RealTime();
   element->ProcTime = procStopWatch->RealTime();
 
-  pdg = TDatabasePDG::Instance();
+  pdg = &DelphesPDGTable::Instance();
 
   for(i = 1; i < pythia->event.size(); ++i)
   {
@@ -112,8 +117,8 @@ void ConvertInput(Long64_t eventCounter, Pythia8::Pythia *pythia,
     candidate->D1 = particle.daughter1() - 1;
     candidate->D2 = particle.daughter2() - 1;
 
-    pdgParticle = pdg->GetParticle(pid);
-    candidate->Charge = pdgParticle ? Int_t(pdgParticle->Charge()/3.0) : -999;
+    pdgParticle = pdg->GetEntry(pid);
+    candidate->Charge = pdgParticle ? pdgParticle->Charge : -999;
     candidate->Mass = mass;
 
     candidate->Momentum.SetPxPyPzE(px, py, pz, e);
@@ -137,6 +142,140 @@ void ConvertInput(Long64_t eventCounter, Pythia8::Pythia *pythia,
 
 //---------------------------------------------------------------------------
 
+void ConvertRecord(Long64_t eventCounter, DelphesEventRecord &record,
+  ExRootTreeBranch *branch, DelphesFactory *factory,
+  TObjArray *allParticleOutputArray, TObjArray *stableParticleOutputArray, TObjArray *partonOutputArray,
+  TStopwatch *readStopWatch, TStopwatch *procStopWatch)
+{
+  HepMCEvent *element;
+
+  // event information
+  element = static_cast<HepMCEvent *>(branch->NewEntry());
+
+  element->Number = eventCounter;
+
+  element->ProcessID = record.ProcessID;
+  element->MPI = record.MPI;
+  element->Weight = record.Weight;
+  element->Scale = record.Scale;
+  element->AlphaQED = record.AlphaQED;
+  element->AlphaQCD = record.AlphaQCD;
+
+  element->ID1 = record.ID1;
+  element->ID2 = record.ID2;
+  element->X1 = record.X1;
+  element->X2 = record.X2;
+  element->ScalePDF = record.ScalePDF;
+  element->PDF1 = record.PDF1;
+  element->PDF2 = record.PDF2;
+
+  element->ReadTime = readStopWatch->RealTime();
+  element->ProcTime = procStopWatch->RealTime();
+
+  record.Materialize(factory, allParticleOutputArray, stableParticleOutputArray, partonOutputArray);
+}
+
+//---------------------------------------------------------------------------
+
+// generates the events of one Pythia instance into event records,
+// runs on a worker thread behind a DelphesEventPipeline
+
+class Pythia8Generator: public DelphesReader
+{
+public:
+
+  Pythia8Generator(Pythia8::Pythia *pythia, Long64_t numberOfEvents,
+    Long64_t timesAllowErrors, atomic< Long64_t > *errorCounter) :
+    fPythia(pythia), fNumberOfEvents(numberOfEvents), fEventCounter(0),
+    fTimesAllowErrors(timesAllowErrors), fErrorCounter(errorCounter)
+  {
+  }
+
+  void SetInputFile(FILE *inputFile) { }
+
+  void Clear() { }
+
+  bool ReadEvent(DelphesEventRecord &record);
+
+private:
+
+  Pythia8::Pythia *fPythia;
+
+  Long64_t fNumberOfEvents, fEventCounter, fTimesAllowErrors;
+
+  // errors of all the workers, counted against Main:timesAllowErrors
+  atomic< Long64_t > *fErrorCounter;
+};
+
+//---------------------------------------------------------------------------
+
+bool Pythia8Generator::ReadEvent(DelphesEventRecord &record)
+{
+  const DelphesPDGTable &pdg = DelphesPDGTable::Instance();
+  int i, status;
+
+  if(fEventCounter >= fNumberOfEvents) return false;
+
+  while(!fPythia->next())
+  {
+    // If failure because reached end of file then exit event loop
+    if(fPythia->info.atEndOfFile())
+    {
+      cerr << "Aborted since reached end of Les Houches Event File" << endl;
+      return false;
+    }
+
+    // First few failures write off as "acceptable" errors, then quit
+    if(++(*fErrorCounter) > fTimesAllowErrors)
+    {
+      cerr << "Event generation aborted prematurely, owing to error!" << endl;
+      return false;
+    }
+  }
+
+  ++fEventCounter;
+
+  record.Clear();
+
+  record.ProcessID = fPythia->info.code();
+  record.MPI = 1;
+  record.Weight = fPythia->info.weight();
+  record.Scale = fPythia->info.QRen();
+  record.AlphaQED = fPythia->info.alphaEM();
+  record.AlphaQCD = fPythia->info.alphaS();
+
+  record.ID1 = fPythia->info.id1();
+  record.ID2 = fPythia->info.id2();
+  record.X1 = fPythia->info.x1();
+  record.X2 = fPythia->info.x2();
+  record.ScalePDF = fPythia->info.QFac();
+  record.PDF1 = fPythia->info.pdf1();
+  record.PDF2 = fPythia->info.pdf2();
+
+  for(i = 1; i < fPythia->event.size(); ++i)
+  {
+    Pythia8::Particle &particle = fPythia->event[i];
+
+    status = particle.statusHepMC();
+
+    record.AddParticle(particle.id(), status,
+      particle.mother1() - 1, particle.mother2() - 1,
+      particle.daughter1() - 1, particle.daughter2() - 1,
+      particle.px(), particle.py(), particle.pz(), particle.e(), particle.m(),
+      particle.xProd(), particle.yProd(), particle.zProd(), particle.tProd());
+
+    // as in ConvertInput, all known particles with status 1 are stable
+    if(status == 1 && pdg.GetEntry(particle.id()))
+    {
+      record.Output.back() = DelphesEventRecord::kStable;
+    }
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
 static bool interrupted = false;
 
 void SignalHandler(int sig)
@@ -164,9 +303,18 @@ int main(int argc, char *argv[])
   DelphesLHEFReader *reader = 0;
   Long64_t eventCounter, errorCounter;
   Long64_t numberOfEvents, timesAllowErrors;
+  Int_t pythiaThreads, prefetchEvents, seed, i;
+  stringstream seedCommand;
 
   Pythia8::Pythia *pythia = 0;
 
+  // parallel generation
+  vector< Pythia8::Pythia * > workers;
+  vector< Pythia8Generator * > generators;
+  vector< DelphesEventPipeline * > pipelines;
+  atomic< Long64_t > workerErrors(0);
+  DelphesEventRecord record;
+
   if(argc != 4)
   {
     cout << " Usage: " << appName << " config_file" << " pythia_card" << " output_file" << endl;
@@ -201,6 +349,19 @@ int main(int argc, char *argv[])
     confReader = new ExRootConfReader;
     confReader->ReadFile(argv[1]);
 
+    pythiaThreads = confReader->GetInt("::PythiaThreads", 0);
+    prefetchEvents = confReader->GetInt("::PrefetchEvents", 0);
+
+    if(pythiaThreads < 0)
+    {
+      throw runtime_error("PythiaThreads must be zero or positive");
+    }
+
+    if(prefetchEvents < 0)
+    {
+      throw runtime_error("PrefetchEvents must be zero or positive");
+    }
+
     modularDelphes = new Delphes("Delphes");
     modularDelphes->SetConfReader(confReader);
     modularDelphes->SetTreeWriter(treeWriter);
@@ -239,9 +400,48 @@ int main(int argc, char *argv[])
       partonOutputArrayLHEF = modularDelphes->ExportArray("partonsLHEF");
     }
 
+    if(reader && pythiaThreads > 0)
+    {
+      cerr << "** WARNING: PythiaThreads is ignored with Les Houches Event File input" << endl;
+      pythiaThreads = 0;
+    }
+
     modularDelphes->InitTask();
 
-    pythia->init();
+    if(pythiaThreads > 0)
+    {
+      // each worker runs its own Pythia instance with the seed of the card
+      // plus its number, and generates every pythiaThreads-th event
+      seed = pythia->mode("Random:seed");
+
+      for(i = 0; i < pythiaThreads; ++i)
+      {
+        workers.push_back(new Pythia8::Pythia);
+        workers[i]->readFile(argv[2]);
+
+        seedCommand.str("");
+        seedCommand << "Random:seed = " << GetPythia8WorkerSeed(seed, i);
+        workers[i]->readString("Random:setSeed = on");
+        workers[i]->readString(seedCommand.str());
+        workers[i]->init();
+
+        generators.push_back(new Pythia8Generator(workers[i],
+          (numberOfEvents - i + pythiaThreads - 1)/pythiaThreads,
+          timesAllowErrors, &workerErrors));
+
+        pipelines.push_back(new DelphesEventPipeline(generators[i],
+          prefetchEvents > 0 ? prefetchEvents : 2));
+      }
+
+      for(i = 0; i < pythiaThreads; ++i)
+      {
+        pipelines[i]->Start();
+      }
+    }
+    else
+    {
+      pythia->init();
+    }
 
     // ExRootProgressBar progressBar(numberOfEvents - 1);
     ExRootProgressBar progressBar(-1);
@@ -253,10 +453,18 @@ int main(int argc, char *argv[])
     readStopWatch.Start();
     for(eventCounter = 0; eventCounter < numberOfEvents && !interrupted; ++eventCounter)
     {
-      while(reader && reader->ReadBlock(factory, allParticleOutputArrayLHEF,
-        stableParticleOutputArrayLHEF, partonOutputArrayLHEF) && !reader->EventReady());
+      if(pythiaThreads > 0)
+      {
+        // the workers take turns, so the output does not depend on their speed
+        if(!pipelines[eventCounter % pythiaThreads]->Next(record)) break;
+      }
+      else
+      {
+        while(reader && reader->ReadBlock(factory, allParticleOutputArrayLHEF,
+          stableParticleOutputArrayLHEF, partonOutputArrayLHEF) && !reader->EventReady());
+      }
 
-      if(!pythia->next())
+      if(pythiaThreads == 0 && !pythia->next())
       {
         // If failure because reached end of file then exit event loop
         if(pythia->info.atEndOfFile())
@@ -280,9 +488,18 @@ int main(int argc, char *argv[])
       readStopWatch.Stop();
 
       procStopWatch.Start();
-      ConvertInput(eventCounter, pythia, branchEvent, factory,
-        allParticleOutputArray, stableParticleOutputArray, partonOutputArray,
-        &readStopWatch, &procStopWatch);
+      if(pythiaThreads > 0)
+      {
+        ConvertRecord(eventCounter, record, branchEvent, factory,
+          allParticleOutputArray, stableParticleOutputArray, partonOutputArray,
+          &readStopWatch, &procStopWatch);
+      }
+      else
+      {
+        ConvertInput(eventCounter, pythia, branchEvent, factory,
+          allParticleOutputArray, stableParticleOutputArray, partonOutputArray,
+          &readStopWatch, &procStopWatch);
+      }
       modularDelphes->ProcessTask();
       procStopWatch.Stop();
 
@@ -305,7 +522,15 @@ int main(int argc, char *argv[])
     progressBar.Update(eventCounter, eventCounter, kTRUE);
     progressBar.Finish();
 
-    pythia->stat();
+    for(i = 0; i < Int_t(pipelines.size()); ++i)
+    {
+      delete pipelines[i];
+      delete generators[i];
+      workers[i]->stat();
+      delete workers[i];
+    }
+
+    if(pythiaThreads == 0) pythia->stat();
 
     modularDelphes->FinishTask();
     treeWriter->Write();
@@ -323,6 +548,10 @@ int main(int argc, char *argv[])
   }
   catch(runtime_error &e)
   {
+    for(i = 0; i < Int_t(pipelines.size()); ++i)
+    {
+      delete pipelines[i];
+    }
     if(treeWriter) delete treeWriter;
     if(outputFile) delete outputFile;
     cerr << "** ERROR: " << e.what() << endl;